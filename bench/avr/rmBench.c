@@ -0,0 +1,445 @@
+//******************************************************************************
+// rmBench(AVR)
+// Cycle counts of RmCore/RmComm on ATmega328P, intended to run under simavr.
+//******************************************************************************
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "RmComm.h"
+
+/* RM_GetCRC() is not exported by RmCore.h, the script uses it to build host frames */
+uint8_t RM_GetCRC( uint8_t buffer[], uint16_t bufferSize );
+
+#define BENCH_MILLIS_COUNT      10
+#define BENCH_PASSKEY           0x0000FFFFUL
+#define BENCH_ITERATION         16
+#define BENCH_FEED_CHUNK        8       /* fed bytes per RMComm_Run(), below RMCOMM_RXBUFFER_SIZE */
+#define BENCH_SETLOG_UNIT_MAX   8       /* entries per SetLogData frame with 2-byte address */
+
+/* Definitions of Serial Line Internet Protocol */
+#define BENCH_SLIP_END          0xC0
+#define BENCH_SLIP_ESC          0xDB
+#define BENCH_SLIP_ESC_END      0xDC
+#define BENCH_SLIP_ESC_ESC      0xDD
+
+typedef struct BENCH_RESULT
+{
+    uint32_t total;
+    uint32_t max;
+    uint16_t count;
+} Bench_Result;
+
+/*-- begin: static variables --*/
+const char benchVersion[] = "rmBench";
+
+uint32_t benchVar32[32];
+uint16_t benchVar16[32];
+uint8_t  benchDumpArea[128];
+
+volatile uint16_t benchOverflowCnt;
+uint32_t benchOffset;
+uint32_t benchWorstRun;
+uint8_t  benchMasterCnt = 0x10;
+
+/*-- begin: functions --*/
+
+ISR(TIMER1_OVF_vect)
+{
+    benchOverflowCnt++;
+}
+
+static int bench_putchar(char c, FILE *stream)
+{
+    (void)stream;
+    while( (UCSR0A & (1 << UDRE0)) == 0 )
+    {
+    }
+    UDR0 = c;
+    return 0;
+}
+
+static FILE bench_stdout = FDEV_SETUP_STREAM(bench_putchar, NULL, _FDEV_SETUP_WRITE);
+
+/**
+ * @fn uint32_t bench_now(void)
+ * @brief Returns a 32-bit cycle count built from Timer1 and its overflow counter.
+ */
+static uint32_t bench_now(void)
+{
+    uint8_t sreg;
+    uint16_t low;
+    uint16_t high;
+
+    sreg = SREG;
+    cli();
+    low = TCNT1;
+    high = benchOverflowCnt;
+    if( (TIFR1 & (1 << TOV1)) && (low < 0x8000) )
+    {
+        high++;
+    }
+    SREG = sreg;
+
+    return ((uint32_t)high << 16) | low;
+}
+
+static uint32_t bench_elapsed(uint32_t start)
+{
+    return bench_now() - start - benchOffset;
+}
+
+static void bench_add(Bench_Result* pResult, uint32_t cycles)
+{
+    pResult->total += cycles;
+    pResult->count++;
+    if( cycles > pResult->max )
+    {
+        pResult->max = cycles;
+    }
+}
+
+static void bench_print(const char* name, Bench_Result* pResult)
+{
+    printf("bench: %-16s avg=%lu max=%lu n=%u\n", name,
+           pResult->total / pResult->count, pResult->max, pResult->count);
+}
+
+/**
+ * @fn uint32_t bench_run(void)
+ * @brief Calls RMComm_Run() once and keeps the worst-case duration.
+ */
+static uint32_t bench_run(void)
+{
+    uint32_t start;
+    uint32_t cycles;
+
+    start = bench_now();
+    RMComm_Run();
+    cycles = bench_elapsed(start);
+
+    if( cycles > benchWorstRun )
+    {
+        benchWorstRun = cycles;
+    }
+
+    return cycles;
+}
+
+/**
+ * @fn uint16_t bench_drain(void)
+ * @brief Emulates the transmission interrupts and discards the encoded bytes.
+ */
+static uint16_t bench_drain(void)
+{
+    uint8_t data;
+    uint16_t count = 0;
+
+    if( RMComm_TryTransmission(&data) )
+    {
+        count++;
+        while( RMComm_GetTransmitData(&data) )
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @fn uint16_t bench_encode_frame(uint8_t opcode, const uint8_t payload[], uint8_t length, uint8_t out[])
+ * @brief Builds a SLIP encoded request frame as the host would send it.
+ */
+static uint16_t bench_encode_frame(uint8_t opcode, const uint8_t payload[], uint8_t length, uint8_t out[])
+{
+    uint8_t frame[RM_RCV_FRAME_BUFF_SIZE];
+    uint8_t index;
+    uint16_t out_index = 0;
+
+    frame[0] = benchMasterCnt | opcode;
+    benchMasterCnt += 0x10;
+    if( benchMasterCnt == 0 )
+    {
+        benchMasterCnt = 0x10;
+    }
+
+    for( index = 0; index < length; index++ )
+    {
+        frame[1 + index] = payload[index];
+    }
+    frame[1 + length] = RM_GetCRC(frame, 1 + length);
+
+    out[out_index++] = BENCH_SLIP_END;
+    for( index = 0; index < (2 + length); index++ )
+    {
+        if( frame[index] == BENCH_SLIP_END )
+        {
+            out[out_index++] = BENCH_SLIP_ESC;
+            out[out_index++] = BENCH_SLIP_ESC_END;
+        }
+        else if( frame[index] == BENCH_SLIP_ESC )
+        {
+            out[out_index++] = BENCH_SLIP_ESC;
+            out[out_index++] = BENCH_SLIP_ESC_ESC;
+        }
+        else
+        {
+            out[out_index++] = frame[index];
+        }
+    }
+    out[out_index++] = BENCH_SLIP_END;
+
+    return out_index;
+}
+
+/**
+ * @fn void bench_request(uint8_t opcode, const uint8_t payload[], uint8_t length)
+ * @brief Feeds a request frame in chunks, as rm_bg() would, and discards the response.
+ */
+static void bench_request(uint8_t opcode, const uint8_t payload[], uint8_t length)
+{
+    uint8_t raw[2 * RM_RCV_FRAME_BUFF_SIZE + 2];
+    uint16_t size;
+    uint16_t index;
+
+    size = bench_encode_frame(opcode, payload, length, raw);
+
+    for( index = 0; index < size; index++ )
+    {
+        RMComm_SetReceivedData(raw[index]);
+        if( ((index + 1) % BENCH_FEED_CHUNK) == 0 )
+        {
+            bench_run();
+            bench_drain();
+        }
+    }
+
+    bench_run();
+    bench_drain();
+}
+
+static void bench_connect(void)
+{
+    uint8_t payload[4];
+
+    payload[0] = (uint8_t)(BENCH_PASSKEY);
+    payload[1] = (uint8_t)(BENCH_PASSKEY >> 8);
+    payload[2] = (uint8_t)(BENCH_PASSKEY >> 16);
+    payload[3] = (uint8_t)(BENCH_PASSKEY >> 24);
+    bench_request(0x06, payload, sizeof(payload));
+
+    payload[0] = BENCH_MILLIS_COUNT;
+    payload[1] = 0;
+    bench_request(0x03, payload, 2);
+}
+
+/**
+ * @fn void bench_set_log(uint8_t count, uint8_t size)
+ * @brief Registers count variables of size bytes through SetLogData frames.
+ */
+static void bench_set_log(uint8_t count, uint8_t size)
+{
+    uint8_t payload[1 + BENCH_SETLOG_UNIT_MAX * 3];
+    uint8_t done = 0;
+    uint8_t unit;
+    uint8_t index;
+    uint16_t address;
+
+    while( done < count )
+    {
+        unit = count - done;
+        if( unit > BENCH_SETLOG_UNIT_MAX )
+        {
+            unit = BENCH_SETLOG_UNIT_MAX;
+        }
+
+        payload[0] = 0x00;
+        if( done == 0 )
+        {
+            payload[0] |= 0x10;     /* start of SetLogDataFrame */
+        }
+        if( (done + unit) == count )
+        {
+            payload[0] |= 0x20;     /* end of SetLogDataFrame */
+        }
+
+        for( index = 0; index < unit; index++ )
+        {
+            if( size == 4 )
+            {
+                address = (uint16_t)&benchVar32[done + index];
+            }
+            else
+            {
+                address = (uint16_t)&benchVar16[done + index];
+            }
+            payload[1 + index * 3] = size;
+            payload[2 + index * 3] = (uint8_t)(address);
+            payload[3 + index * 3] = (uint8_t)(address >> 8);
+        }
+
+        bench_request(0x05, payload, 1 + unit * 3);
+        done += unit;
+    }
+}
+
+static void bench_receive(void)
+{
+    uint8_t raw[2 * RM_RCV_FRAME_BUFF_SIZE + 2];
+    uint8_t payload[3];
+    uint16_t size;
+    uint16_t index;
+    uint16_t iteration;
+    uint32_t start;
+    uint32_t cycles;
+    RM_ReceivedData rx;
+
+    payload[0] = (uint8_t)((uint16_t)benchDumpArea);
+    payload[1] = (uint8_t)((uint16_t)benchDumpArea >> 8);
+    payload[2] = sizeof(benchDumpArea);
+    size = bench_encode_frame(0x07, payload, sizeof(payload), raw);
+
+    memset(&rx, 0, sizeof(rx));     /* RM_FRAMING_SLIP where COBS is supported */
+    RM_ClearReceivedState(&rx);
+    start = bench_now();
+    for( iteration = 0; iteration < BENCH_ITERATION; iteration++ )
+    {
+        for( index = 0; index < size; index++ )
+        {
+            RM_DecodeReceivedData(&rx, raw[index]);
+        }
+        RM_ClearReceivedState(&rx);
+    }
+    cycles = bench_elapsed(start);
+    printf("bench: rx_decode_byte   %lu/100\n", (cycles * 100) / ((uint32_t)size * BENCH_ITERATION));
+
+    start = bench_now();
+    for( index = 0; index < size; index++ )
+    {
+        RMComm_SetReceivedData(raw[index]);
+    }
+    cycles = bench_elapsed(start);
+    printf("bench: rx_enqueue_byte  %lu/100\n", (cycles * 100) / size);
+
+    /* The frame is complete, let RMComm_Run() process and answer it */
+    bench_run();
+    bench_drain();
+}
+
+static void bench_log(uint8_t count, uint8_t size)
+{
+    Bench_Result task = {0, 0, 0};
+    Bench_Result encode = {0, 0, 0};
+    uint16_t iteration;
+    uint32_t start;
+    uint16_t bytes = 0;
+    char name[20];
+
+    bench_set_log(count, size);
+    bench_request(0x01, 0, 0);  /* log start */
+
+    for( iteration = 0; iteration < BENCH_ITERATION; iteration++ )
+    {
+        bench_add(&task, bench_run());
+
+        start = bench_now();
+        bytes = bench_drain();
+        bench_add(&encode, bench_elapsed(start));
+    }
+
+    bench_request(0x02, 0, 0);  /* log stop */
+
+    sprintf(name, "log%u_task", count);
+    bench_print(name, &task);
+    sprintf(name, "log%u_encode", count);
+    bench_print(name, &encode);
+    printf("bench: log%u_frame_bytes  %u\n", count, bytes);
+}
+
+static void bench_dump(void)
+{
+    Bench_Result task = {0, 0, 0};
+    Bench_Result encode = {0, 0, 0};
+    uint8_t raw[2 * RM_RCV_FRAME_BUFF_SIZE + 2];
+    uint8_t payload[3];
+    uint16_t size;
+    uint16_t index;
+    uint16_t iteration;
+    uint32_t start;
+
+    payload[0] = (uint8_t)((uint16_t)benchDumpArea);
+    payload[1] = (uint8_t)((uint16_t)benchDumpArea >> 8);
+    payload[2] = sizeof(benchDumpArea);
+
+    for( iteration = 0; iteration < BENCH_ITERATION; iteration++ )
+    {
+        size = bench_encode_frame(0x07, payload, sizeof(payload), raw);
+        for( index = 0; index < size; index++ )
+        {
+            RMComm_SetReceivedData(raw[index]);
+        }
+
+        bench_add(&task, bench_run());
+
+        start = bench_now();
+        bench_drain();
+        bench_add(&encode, bench_elapsed(start));
+    }
+
+    bench_print("dump128_task", &task);
+    bench_print("dump128_encode", &encode);
+}
+
+int main(void)
+{
+    uint16_t index;
+    uint32_t start;
+
+    UBRR0 = 0;
+    UCSR0A = (1 << U2X0);
+    UCSR0B = (1 << TXEN0);
+    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+    stdout = &bench_stdout;
+
+    TCCR1A = 0;
+    TCCR1B = (1 << CS10);
+    TIMSK1 = (1 << TOIE1);
+    sei();
+
+    start = bench_now();
+    benchOffset = bench_now() - start;
+
+    for( index = 0; index < 32; index++ )
+    {
+        benchVar32[index] = 0xC0DB0000UL + index;   /* worst case for SLIP escaping */
+        benchVar16[index] = index;
+    }
+
+    printf("bench: start F_CPU=%lu\n", (uint32_t)F_CPU);
+
+    RMComm_Initialize((uint8_t *)benchVersion, sizeof(benchVersion), BENCH_MILLIS_COUNT, BENCH_PASSKEY);
+    bench_connect();
+
+    bench_receive();
+    bench_log(1, 4);
+    bench_log(8, 4);
+    bench_log(32, 2);
+    bench_dump();
+
+    printf("bench: worst_run        %lu\n", benchWorstRun);
+    printf("bench: done\n");
+
+    /* simavr quits when the cpu sleeps with interrupts disabled */
+    cli();
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_cpu();
+
+    return 0;
+}
+
+/*-- end of file --*/
@@ -14,13 +14,25 @@
 
 #define RMCOMM_DERIVED_HEADER_SIZE  2
 
-
+/* Orders the data of a ring slot against the index that publishes or releases it */
+#ifdef __AVR__
+#define RMCOMM_RING_FENCE()         __asm__ __volatile__( "" ::: "memory" )
+#else
+#define RMCOMM_RING_FENCE()         __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+/* head is only written by the consumer and tail only by the producer, so one producer and
+   one consumer may run in different contexts (interrupt, thread). A second producer or
+   consumer needs a lock of the caller. The buffer sizes keep the indices below 128, so
+   even the two byte accesses of AVR cannot tear them. */
 typedef struct RMCOMM_RINGBUFFER
 {
     uint8_t* buffer;
-    uint16_t head;
-    uint16_t tail;
+    volatile uint16_t head;
+    volatile uint16_t tail;
     uint16_t mask;
+    uint16_t highWaterMark;
+    uint32_t overflowCnt;
 } RMComm_RingBuffer;
 
 
@@ -30,6 +42,7 @@ bool RMComm_RingBuffer_Remove(RMComm_RingBuffer* pContents);
 bool RMComm_RingBuffer_Dequeue(RMComm_RingBuffer* pContents, uint8_t* pData);
 bool RMComm_RingBuffer_Enqueue(RMComm_RingBuffer* pContents, uint8_t data);
 uint16_t RMComm_RingBuffer_Available(RMComm_RingBuffer* pContents);
+uint16_t RMComm_RingBuffer_Free(RMComm_RingBuffer* pContents);
 
 /*-- begin: static variables --*/
 RM_contents RMCore_object;
@@ -43,6 +56,11 @@ uint8_t RMComm_rxIntrBuffer[RMCOMM_RXINTRBUFFER_SIZE];
 RMComm_RingBuffer RMComm_sendInterruptTransfer;
 uint8_t RMComm_txIntrBuffer[RMCOMM_TXINTRBUFFER_SIZE];
 
+RMComm_WritePolicy RMComm_writePolicy = RMCOMM_WRITE_POLICY_DROP_NEWEST;
+uint16_t RMComm_writeTimeout = 0;
+bool RMComm_isOfflineBuffering = false;
+rmcomm_millis_function_t RMComm_millisFunction = (rmcomm_millis_function_t)0x00000000;
+
 
 
 /*-- begin: prototype of function --*/
@@ -66,6 +84,10 @@ void RMComm_Initialize( uint8_t version[], uint16_t versionSize, uint16_t millis
     RMComm_RingBuffer_Initialize(&RMComm_receiveInterruptTransfer, &RMComm_rxIntrBuffer[0], sizeof(RMComm_rxIntrBuffer));
     RMComm_RingBuffer_Initialize(&RMComm_sendInterruptTransfer, &RMComm_txIntrBuffer[0], sizeof(RMComm_txIntrBuffer));
 
+#ifdef RM_SUPPORT_PROFILING
+    RM_InitializeProfile();
+#endif
+
 }
 
 /**
@@ -81,6 +103,8 @@ void RMComm_Run( void )
 
     if(RMCore_object.rxData.status != RM_RECEIVED_STATUS_COMPLETE)
     {
+        RM_PROFILE_BEGIN(profile_start);
+
         size = RMComm_RingBuffer_Available(&RMComm_receiveData);
         while(size > 0)
         {
@@ -94,12 +118,16 @@ void RMComm_Run( void )
 
         }
 
+        RM_PROFILE_END(RM_PROFILE_STAGE_DECODE, profile_start);
     }
 
     if( RMCore_object.rxData.status == RM_RECEIVED_STATUS_COMPLETE )
     {
         if( RMCore_object.rxData.buffer[RMCOMM_FRAME_IDENTIFICATION_IDX] == RMCOMM_DERIVED_FRAME )
         {
+#ifdef RM_SUPPORT_STATISTICS
+            RMCore_object.statistics.framesReceived++;
+#endif
             if(RMCore_object.rxData.buffer[RMCOMM_DERIVED_MODE_IDX] == RMCOMM_DERIVED_MODE_SERIALCOMM_EMULATION)
             {
                 for(index = RMCOMM_DERIVED_PAYLOAD_IDX; index < RMCore_object.rxData.length; index++)
@@ -113,6 +141,12 @@ void RMComm_Run( void )
 
     }
 
+#ifdef RM_SUPPORT_STATISTICS
+    RMCore_object.statistics.ringOverflows = RMComm_receiveData.overflowCnt +
+                                             RMComm_receiveInterruptTransfer.overflowCnt +
+                                             RMComm_sendInterruptTransfer.overflowCnt;
+#endif
+
     RM_Task(&RMCore_object);
 
     size = RMComm_RingBuffer_Available(&RMComm_sendInterruptTransfer);
@@ -123,9 +157,9 @@ void RMComm_Run( void )
         RMCore_object.txData.buffer[RMCOMM_FRAME_IDENTIFICATION_IDX] = RMCOMM_DERIVED_FRAME;
         RMCore_object.txData.buffer[RMCOMM_DERIVED_MODE_IDX] = RMCOMM_DERIVED_MODE_SERIALCOMM_EMULATION;
 
-        if(size > sizeof(RMCore_object.txData.buffer))
+        if(size > (sizeof(RMCore_object.txData.buffer) - RMCOMM_DERIVED_HEADER_SIZE))
         {
-            size = sizeof(RMCore_object.txData.buffer);
+            size = sizeof(RMCore_object.txData.buffer) - RMCOMM_DERIVED_HEADER_SIZE;
         }
 
         for(index = 0; index < size; index++)
@@ -137,6 +171,9 @@ void RMComm_Run( void )
         RMCore_object.txData.currentIndex = 0;
         RMCore_object.txData.maxIndex = RMCOMM_DERIVED_HEADER_SIZE + size;
         RMCore_object.txData.status = RM_TRANSMIT_STATUS_READY;
+#ifdef RM_SUPPORT_STATISTICS
+        RMCore_object.statistics.framesSent++;
+#endif
 
     }
     
@@ -170,7 +207,13 @@ bool RMComm_TryTransmission( uint8_t* pData )
  */
 bool RMComm_GetTransmitData( uint8_t* pData )
 {
-    return RM_EncodeTransmitData(&RMCore_object.txData, pData);
+    bool is_available;
+    RM_PROFILE_BEGIN(profile_start);
+
+    is_available = RM_EncodeTransmitData(&RMCore_object.txData, pData);
+
+    RM_PROFILE_END(RM_PROFILE_STAGE_ENCODE, profile_start);
+    return is_available;
 }
 
 /**
@@ -195,6 +238,61 @@ bool RMComm_IsConnected()
     return RMCore_object.isLogging;
 }
 
+/**
+ * @fn bool RMComm_IsIdle(void)
+ * @brief Checks if RMComm_Run() has nothing to do until new data is received.
+ *
+ * Event driven transports can stop calling RMComm_Run() periodically while this returns true.
+ *
+ * @return True if no frame is being received, processed or transmitted, logging is stopped
+ *         and neither a trigger, a region hash nor a pending bypass request is running.
+ */
+bool RMComm_IsIdle(void)
+{
+#ifdef RM_SUPPORT_TRIGGER
+    if( RMCore_object.trigger.state == RM_TRIGGER_STATE_ARMED ||
+        RMCore_object.trigger.state == RM_TRIGGER_STATE_TRIGGERED )
+    {
+        return false;
+    }
+#endif
+
+#ifdef RM_SUPPORT_HASH
+    if( RMCore_object.hash.state == RM_HASH_STATE_RUNNING )
+    {
+        return false;
+    }
+#endif
+
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+    /* RMComm_CompleteBypass() does not wake the caller, RMComm_Run() has to keep polling */
+    if( RMCore_object.bypassState != RM_BYPASS_STATE_IDLE )
+    {
+        return false;
+    }
+#endif
+
+    return RMCore_object.isLogging == false &&
+           RMCore_object.isRequestFinished == true &&
+           RMCore_object.rxData.status == RM_RECEIVED_STATUS_READY &&
+           RMCore_object.txData.status == RM_TRANSMIT_STATUS_COMPLETE &&
+           RMComm_RingBuffer_Available(&RMComm_receiveData) == 0;
+}
+
+/**
+ * @fn uint16_t RMComm_GatherLogData(uint8_t buffer[])
+ * @brief Copies the current values of the log table configured by the host, without framing.
+ *
+ * This lets other backends publish samples at their own rate. It must run in the same context as RMComm_Run().
+ *
+ * @param buffer Array of at least RM_SND_PAYLOAD_SIZE bytes.
+ * @return The number of bytes written, 0 if no log table is set.
+ */
+uint16_t RMComm_GatherLogData( uint8_t buffer[] )
+{
+    return RM_GatherLogData(&RMCore_object.log, buffer);
+}
+
 /**
  * @fn void RMComm_AttachBypassFunction(rm_bypass_function_t func)
  * @brief Attaches a user-defined bypass function to the RMComm system.
@@ -206,6 +304,220 @@ void RMComm_AttachBypassFunction( rm_bypass_function_t func )
     RMCore_object.bypassFunction = func;
 }
 
+#ifdef RM_SUPPORT_COMMAND_TABLE
+/**
+ * @fn void RMComm_AttachCommands(const rm_command_function_t table[], uint8_t count)
+ * @brief Attaches the bypass sub-commands, dispatched by the first byte of the request.
+ *
+ * Requests with an ID beyond count or a NULL entry still go to the bypass function.
+ *
+ * @param table Array of handlers in RM_FLASH, indexed by sub-command ID.
+ * @param count Number of entries.
+ */
+void RMComm_AttachCommands( const rm_command_function_t table[], uint8_t count )
+{
+    RM_AttachCommands(&RMCore_object, table, count);
+}
+#endif
+
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+/**
+ * @fn bool RMComm_CompleteBypass(RM_BypassResponse response)
+ * @brief Sends the response of a bypass request whose function returned RM_STATUS_PENDING.
+ *
+ * Call it from the context that calls RMComm_Run(). response.buffer has to stay valid until the response is sent.
+ *
+ * @param response Response of the bypass request.
+ * @return true if a bypass request was pending, false otherwise.
+ */
+bool RMComm_CompleteBypass( RM_BypassResponse response )
+{
+    return RM_CompleteBypass(&RMCore_object, response);
+}
+#endif
+
+#ifdef RM_SUPPORT_REGISTRY
+/**
+ * @fn void RMComm_AttachRegistry(const RM_RegistryEntry table[], uint16_t count)
+ * @brief Publishes a table of monitored variables, so the host needs no map file.
+ *
+ * @param table Array of entries declared with RM_REGISTRY_ENTRY() in RM_FLASH.
+ * @param count Number of entries.
+ */
+void RMComm_AttachRegistry( const RM_RegistryEntry table[], uint16_t count )
+{
+    RM_AttachRegistry(&RMCore_object, table, count);
+}
+#endif
+
+#ifdef RM_SUPPORT_ACCESS_CHECK
+/**
+ * @fn bool RMComm_AttachAccessRegions(const RM_AccessRegion table[], uint16_t count)
+ * @brief Restricts the addresses the host may log, dump and write.
+ *
+ * @param table Array of regions sorted by start, in RM_FLASH.
+ * @param count Number of regions.
+ * @return True if the table is attached, false if it is not sorted or regions overlap.
+ */
+bool RMComm_AttachAccessRegions( const RM_AccessRegion table[], uint16_t count )
+{
+    return RM_AttachAccessRegions(&RMCore_object, table, count);
+}
+#endif
+
+#ifdef RM_SUPPORT_SESSION
+/**
+ * @fn void RMComm_AttachStorage(rm_storage_function_t saveFunc, rm_storage_function_t loadFunc)
+ * @brief Attaches the storage hooks that let the host resume logging after a reset.
+ *
+ * @param saveFunc Writes the session record to EEPROM, flash or a file.
+ * @param loadFunc Reads the session record back.
+ */
+void RMComm_AttachStorage( rm_storage_function_t saveFunc, rm_storage_function_t loadFunc )
+{
+    RM_AttachStorage(&RMCore_object, saveFunc, loadFunc);
+}
+
+/**
+ * @fn void RMComm_AttachBuildId(const uint8_t id[], uint16_t size)
+ * @brief Attaches an identifier of the firmware image, so a rebuild does not resume a stale session.
+ *
+ * @param id[] Array containing the identifier, it must stay valid.
+ * @param size Size of the id array.
+ */
+void RMComm_AttachBuildId( const uint8_t id[], uint16_t size )
+{
+    RM_AttachBuildId(&RMCore_object, id, size);
+}
+#endif
+
+#ifdef RM_SUPPORT_LOG_PROFILE
+/**
+ * @fn void RMComm_AttachLogProfiles(const RM_LogProfile table[], uint16_t count)
+ * @brief Attaches log profiles compiled into the firmware, the host selects them by index.
+ *
+ * @param table Array of profiles declared with RM_LOG_PROFILE() in RM_FLASH.
+ * @param count Number of profiles.
+ */
+void RMComm_AttachLogProfiles( const RM_LogProfile table[], uint16_t count )
+{
+    RM_AttachLogProfiles(&RMCore_object, table, count);
+}
+
+/**
+ * @fn bool RMComm_SelectLogProfile(uint8_t index)
+ * @brief Switches the log table from the application, for example when a fault is detected.
+ *
+ * @param index Profile index, compiled-in profiles first.
+ * @return True if the profile is active, false otherwise.
+ */
+bool RMComm_SelectLogProfile( uint8_t index )
+{
+    return RM_SelectLogProfile(&RMCore_object, index);
+}
+#endif
+
+/**
+ * @fn void RMComm_AttachMillisFunction(rmcomm_millis_function_t func)
+ * @brief Attaches a millisecond time source used by RMCOMM_WRITE_POLICY_BLOCK.
+ *
+ * @param func The function pointer returning a free running millisecond count.
+ */
+void RMComm_AttachMillisFunction( rmcomm_millis_function_t func )
+{
+    RMComm_millisFunction = func;
+}
+
+/**
+ * @fn void RMComm_SetWritePolicy(RMComm_WritePolicy policy, uint16_t timeoutMillis, bool isOfflineBuffering)
+ * @brief Selects how RMComm_Write() behaves when the send buffer is full.
+ *
+ * RMCOMM_WRITE_POLICY_BLOCK is only useful when RMComm_Write() runs in a different context
+ * (thread or task) than RMComm_Run(), and it requires RMComm_AttachMillisFunction().
+ * Without a time source it behaves like RMCOMM_WRITE_POLICY_DROP_NEWEST.
+ * That context must be the only one writing, the send buffer has a single producer.
+ * RMCOMM_WRITE_POLICY_DROP_OLDEST removes bytes on the consumer side, so RMComm_Write() and
+ * RMComm_Run() must share one context.
+ *
+ * @param policy Overflow policy.
+ * @param timeoutMillis Maximum waiting time for RMCOMM_WRITE_POLICY_BLOCK.
+ * @param isOfflineBuffering True keeps data written while RM is not connected, false discards it.
+ */
+void RMComm_SetWritePolicy( RMComm_WritePolicy policy, uint16_t timeoutMillis, bool isOfflineBuffering )
+{
+    RMComm_writePolicy = policy;
+    RMComm_writeTimeout = timeoutMillis;
+    RMComm_isOfflineBuffering = isOfflineBuffering;
+}
+
+/**
+ * @fn bool RMComm_GetRingStatus(RMComm_RingId id, RMComm_RingStatus* pStatus)
+ * @brief Reports the fill level, high-water mark and overflow count of a ring buffer.
+ *
+ * @param id Identifier of the ring buffer.
+ * @param pStatus Pointer to store the status.
+ * @return True if id is valid, false otherwise.
+ */
+bool RMComm_GetRingStatus( RMComm_RingId id, RMComm_RingStatus* pStatus )
+{
+    RMComm_RingBuffer* ring;
+
+    switch( id )
+    {
+    case RMCOMM_RING_RECEIVE:
+        ring = &RMComm_receiveData;
+        break;
+
+    case RMCOMM_RING_RECEIVE_EMULATION:
+        ring = &RMComm_receiveInterruptTransfer;
+        break;
+
+    case RMCOMM_RING_SEND_EMULATION:
+        ring = &RMComm_sendInterruptTransfer;
+        break;
+
+    default:
+        return false;
+    }
+
+    pStatus->capacity = ring->mask;
+    pStatus->used = RMComm_RingBuffer_Available(ring);
+    pStatus->highWaterMark = ring->highWaterMark;
+    pStatus->overflowCnt = ring->overflowCnt;
+
+    return true;
+}
+
+/**
+ * @fn void RMComm_ClearRingStatus(RMComm_RingId id)
+ * @brief Resets the high-water mark and overflow count of a ring buffer.
+ *
+ * @param id Identifier of the ring buffer.
+ */
+void RMComm_ClearRingStatus( RMComm_RingId id )
+{
+    switch( id )
+    {
+    case RMCOMM_RING_RECEIVE:
+        RMComm_receiveData.highWaterMark = 0;
+        RMComm_receiveData.overflowCnt = 0;
+        break;
+
+    case RMCOMM_RING_RECEIVE_EMULATION:
+        RMComm_receiveInterruptTransfer.highWaterMark = 0;
+        RMComm_receiveInterruptTransfer.overflowCnt = 0;
+        break;
+
+    case RMCOMM_RING_SEND_EMULATION:
+        RMComm_sendInterruptTransfer.highWaterMark = 0;
+        RMComm_sendInterruptTransfer.overflowCnt = 0;
+        break;
+
+    default:
+        break;
+    }
+}
+
 /**
  * @fn void RMComm_RingBuffer_Initialize(RMComm_RingBuffer* pContents, uint8_t* array, uint16_t size)
  * Initializes a ring buffer.
@@ -222,6 +534,8 @@ void RMComm_RingBuffer_Initialize(RMComm_RingBuffer *pContents, uint8_t *array,
     pContents->head = 0;
     pContents->tail = 0;
     pContents->buffer = array;
+    pContents->highWaterMark = 0;
+    pContents->overflowCnt = 0;
 
     for(i=0; i<16; i++)
     {
@@ -249,6 +563,7 @@ bool RMComm_RingBuffer_Peek(RMComm_RingBuffer *pContents, uint8_t *pData)
     {
         return false;
     }
+    RMCOMM_RING_FENCE();
     *pData = pContents->buffer[pContents->head];
     return true;
 }
@@ -266,6 +581,7 @@ bool RMComm_RingBuffer_Remove(RMComm_RingBuffer *pContents)
     {
         return false;
     }
+    RMCOMM_RING_FENCE();
     pContents->head = (pContents->head + 1) & pContents->mask;
     return true;
 }
@@ -298,13 +614,22 @@ bool RMComm_RingBuffer_Dequeue(RMComm_RingBuffer *pContents, uint8_t *pData)
  */
 bool RMComm_RingBuffer_Enqueue(RMComm_RingBuffer *pContents, uint8_t data)
 {
+    uint16_t used;
     uint16_t next_tail = (pContents->tail + 1) & pContents->mask;
     if (next_tail == pContents->head)
     {
+        pContents->overflowCnt++;
         return false;
     }
     pContents->buffer[pContents->tail] = data;
+    RMCOMM_RING_FENCE();
     pContents->tail = next_tail;
+
+    used = RMComm_RingBuffer_Available(pContents);
+    if (used > pContents->highWaterMark)
+    {
+        pContents->highWaterMark = used;
+    }
     return true;
 }
 
@@ -322,6 +647,18 @@ uint16_t RMComm_RingBuffer_Available(RMComm_RingBuffer *pContents)
     return length;
 }
 
+/**
+ * @fn uint16_t RMComm_RingBuffer_Free(RMComm_RingBuffer* pContents)
+ * Returns the number of bytes that can be enqueued without overflow.
+ *
+ * @param pContents Pointer to the ring buffer.
+ * @return The number of free bytes.
+ */
+uint16_t RMComm_RingBuffer_Free(RMComm_RingBuffer *pContents)
+{
+    return pContents->mask - RMComm_RingBuffer_Available(pContents);
+}
+
 /**
  * @fn void RMComm_WriteArray(const char *str)
  * Writes a string to the RMComm send interrupt transfer buffer.
@@ -349,11 +686,36 @@ void RMComm_WriteArray(const char *str) {
  */
 void RMComm_Write(uint8_t data)
 {
-    if( RMCore_object.isLogging == false )
+    uint32_t start_millis;
+
+    if( RMCore_object.isLogging == false && RMComm_isOfflineBuffering == false )
     {
         return;
     }
-    
+
+    if( RMComm_RingBuffer_Free(&RMComm_sendInterruptTransfer) == 0 )
+    {
+        if( RMComm_writePolicy == RMCOMM_WRITE_POLICY_DROP_OLDEST )
+        {
+            /* The oldest byte is lost instead of the newest one. This is the consumer's
+               side of the ring, so it is only safe in the context of RMComm_Run(). */
+            RMComm_RingBuffer_Remove(&RMComm_sendInterruptTransfer);
+            RMComm_sendInterruptTransfer.overflowCnt++;
+        }
+        else if( RMComm_writePolicy == RMCOMM_WRITE_POLICY_BLOCK &&
+                 RMComm_millisFunction != (rmcomm_millis_function_t)0x00000000 )
+        {
+            start_millis = RMComm_millisFunction();
+            while( RMComm_RingBuffer_Free(&RMComm_sendInterruptTransfer) == 0 )
+            {
+                if( (RMComm_millisFunction() - start_millis) >= (uint32_t)RMComm_writeTimeout )
+                {
+                    break;
+                }
+            }
+        }
+    }
+
     RMComm_RingBuffer_Enqueue(&RMComm_sendInterruptTransfer, data);
 }
 
@@ -386,6 +748,22 @@ uint16_t RMComm_Available(void)
     return RMComm_RingBuffer_Available(&RMComm_receiveInterruptTransfer);
 }
 
+/**
+ * @fn uint16_t RMComm_AvailableForWrite(void)
+ * Returns the number of bytes that can be written without overflow of the RMComm send interrupt transfer buffer.
+ *
+ * @return The number of bytes, or 0 if written data would be discarded.
+ */
+uint16_t RMComm_AvailableForWrite(void)
+{
+    if( RMCore_object.isLogging == false && RMComm_isOfflineBuffering == false )
+    {
+        return 0;
+    }
+
+    return RMComm_RingBuffer_Free(&RMComm_sendInterruptTransfer);
+}
+
 /**
  * @fn void RMComm_Print(const char str[])
  * Prints a string via the RMComm communication interface.
@@ -21,6 +21,33 @@ typedef float              float32_t;
 typedef long double        float64_t;
 #endif
 
+/* Definitions of overflow policies for RMComm_Write() */
+typedef enum
+{
+  RMCOMM_WRITE_POLICY_DROP_NEWEST = 0,  // discard the byte being written
+  RMCOMM_WRITE_POLICY_DROP_OLDEST,      // discard the oldest queued byte
+  RMCOMM_WRITE_POLICY_BLOCK             // wait for free space until timeout
+} RMComm_WritePolicy;
+
+/* Identifiers of the ring buffers managed by RMComm */
+typedef enum
+{
+  RMCOMM_RING_RECEIVE = 0,          // raw received bytes (RMComm_SetReceivedData)
+  RMCOMM_RING_RECEIVE_EMULATION,    // serial emulation data from the host (RMComm_Read)
+  RMCOMM_RING_SEND_EMULATION,       // serial emulation data to the host (RMComm_Write)
+  RMCOMM_RING_NUM
+} RMComm_RingId;
+
+typedef struct RMCOMM_RINGSTATUS
+{
+    uint16_t capacity;
+    uint16_t used;
+    uint16_t highWaterMark;
+    uint32_t overflowCnt;
+} RMComm_RingStatus;
+
+typedef uint32_t (*rmcomm_millis_function_t)(void);
+
 
 void RMComm_Initialize( uint8_t version[], uint16_t versionSize, uint16_t millisCount, uint32_t passkey );
 void RMComm_Run( void );
@@ -28,11 +55,38 @@ bool RMComm_TryTransmission( uint8_t* pbyte );
 bool RMComm_GetTransmitData( uint8_t* pbyte );
 void RMComm_SetReceivedData( uint8_t data );
 bool RMComm_IsConnected();
+bool RMComm_IsIdle(void);
+uint16_t RMComm_GatherLogData( uint8_t buffer[] );
 void RMComm_AttachBypassFunction( rm_bypass_function_t func );
+#ifdef RM_SUPPORT_COMMAND_TABLE
+void RMComm_AttachCommands( const rm_command_function_t table[], uint8_t count );
+#endif
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+bool RMComm_CompleteBypass( RM_BypassResponse response );
+#endif
+void RMComm_AttachMillisFunction( rmcomm_millis_function_t func );
+#ifdef RM_SUPPORT_REGISTRY
+void RMComm_AttachRegistry( const RM_RegistryEntry table[], uint16_t count );
+#endif
+#ifdef RM_SUPPORT_ACCESS_CHECK
+bool RMComm_AttachAccessRegions( const RM_AccessRegion table[], uint16_t count );
+#endif
+#ifdef RM_SUPPORT_SESSION
+void RMComm_AttachStorage( rm_storage_function_t saveFunc, rm_storage_function_t loadFunc );
+void RMComm_AttachBuildId( const uint8_t id[], uint16_t size );
+#endif
+#ifdef RM_SUPPORT_LOG_PROFILE
+void RMComm_AttachLogProfiles( const RM_LogProfile table[], uint16_t count );
+bool RMComm_SelectLogProfile( uint8_t index );
+#endif
+void RMComm_SetWritePolicy( RMComm_WritePolicy policy, uint16_t timeoutMillis, bool isOfflineBuffering );
+bool RMComm_GetRingStatus( RMComm_RingId id, RMComm_RingStatus* pStatus );
+void RMComm_ClearRingStatus( RMComm_RingId id );
 
 void RMComm_Write(uint8_t data);
 uint8_t RMComm_Read(void);
 uint16_t RMComm_Available(void);
+uint16_t RMComm_AvailableForWrite(void);
 void RMComm_Print(const char str[]);
 void RMComm_Println(void);
 void RMComm_PrintSingedNumber(int32_t n);
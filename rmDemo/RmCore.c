@@ -4,9 +4,28 @@
 //******************************************************************************
 
 #include "RmCore.h"
+#include <string.h>
+#include <stddef.h>
+
+#if defined(RM_SUPPORT_PROFILING) && defined(__linux__)
+#include <time.h>
+#endif
+
+#ifdef RM_SUPPORT_WIDE_CRC
+#if defined(__AVR__)
+#include <util/crc16.h>
+#elif defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+#endif
 
 
 #define RM_BYPASS_FUNC_NULL     (rm_bypass_function_t)0x00000000
+#define RM_COMMAND_FUNC_NULL    (rm_command_function_t)0x00000000
+#define RM_RESPONSE_FUNC_NULL   (rm_response_function_t)0x00000000
+#define RM_STORAGE_FUNC_NULL    (rm_storage_function_t)0x00000000
 
 /* Definitions of SetLogDataFrame */
 #define RM_SETLOG_BIT_MASK      0xF0
@@ -21,13 +40,109 @@
 #define RM_FRAME_CHAR_ESC_ESC   0xDD
 
 /* Definitions of communication mode */
+#define RM_OPCODE_EXTENDED      0x09
+
+/* Definitions of extended request (first payload byte of RM_OPCODE_EXTENDED) */
+#define RM_EXTCODE_STATISTICS   0x01
+#define RM_EXTCODE_PROFILE      0x02
+#define RM_EXTCODE_REGISTRY     0x03
+#define RM_EXTCODE_SETLOG_TABLE 0x04
+#define RM_EXTCODE_SAVE_SESSION 0x05
+#define RM_EXTCODE_RESUME_SESSION   0x06
+#define RM_EXTCODE_SELECT_PROFILE   0x07
+#define RM_EXTCODE_STORE_PROFILE    0x08
+#define RM_EXTCODE_LIST_PROFILES    0x09
+#define RM_EXTCODE_SET_TRIGGER      0x0A
+#define RM_EXTCODE_READ_CAPTURE     0x0B
+#define RM_EXTCODE_SET_LOG_MODE     0x0C
+#define RM_EXTCODE_HASH_REGION      0x0D
+#define RM_EXTCODE_READ_HASH        0x0E
+#define RM_EXTCODE_SNAPSHOT         0x0F
+#define RM_EXTCODE_READ_DIFF        0x10
+#define RM_EXTCODE_COMPRESSED_DUMP  0x11
+#define RM_EXTCODE_SET_FRAMING      0x12
+
+/* Definitions of profile list response */
+#define RM_PROFILE_LIST_HEADER_SIZE 3   /* total(1)+start(1)+count(1) */
+#define RM_PROFILE_LIST_RECORD_SIZE 4   /* period(2)+entries(1)+name length(1), name follows */
+
+/* Definitions of trigger request and capture response */
+#define RM_TRIGGER_HEADER_SIZE      5   /* combine(1)+pre(2)+post(2) */
+#define RM_TRIGGER_RECORD_SIZE      (1 + 1 + RM_ADDRESS_SIZE + 4 + 4)  /* kind(1)+type<<4|size(1)+address+a(4)+b(4) */
+#define RM_CAPTURE_HEADER_SIZE      9   /* state(1)+sample size(2)+total(2)+trigger index(2)+start(2) */
+
+/* Definitions of aggregate request and log frame */
+#define RM_AGGREGATE_RECORD_SIZE    1   /* bins << 4 | type(1), bin lower(4) and bin width(4) follow if bins is not 0 */
+#define RM_AGGREGATE_BIN_SIZE       (4 + 4)
+#define RM_AGGREGATE_HEADER_SIZE    2   /* ticks(2) */
+#define RM_AGGREGATE_ENTRY_SIZE     (4 + 4)  /* min(size)+max(size) precede mean(4)+variance(4), bins(2 each) follow */
+
+/* Definitions of schedule request and log frame */
+#define RM_SCHEDULE_RECORD_SIZE     2   /* count(1)+divisor(1) */
+#define RM_SCHEDULE_HEADER_SIZE     1   /* schedule ID(1) */
+
+/* Definitions of change request */
+#define RM_CHANGE_RECORD_SIZE       5   /* mask << 4 | type(1)+threshold(4) */
+
+/* Definitions of hash response */
+#define RM_HASH_HEADER_SIZE         (1 + RM_ADDRESS_SIZE + 4 + 1)  /* state(1)+hashed(address size)+digest(4)+count(1) */
+
+/* Definitions of diff response */
+#define RM_DIFF_HEADER_SIZE         2   /* next offset(2) */
+#define RM_DIFF_RUN_HEADER_SIZE     3   /* offset(2)+count(1), count bytes follow */
+#define RM_DIFF_BLOCK_SIZE_MAX      (RM_SND_PAYLOAD_SIZE - RM_DIFF_HEADER_SIZE - RM_DIFF_RUN_HEADER_SIZE)
+
+/* Definitions of compressed dump response, consumed(2) and the tokens follow */
+#define RM_RLE_HEADER_SIZE          2
+#define RM_RLE_LITERAL_MAX          0x80    /* 0x00-0x7F: control + 1 bytes follow as they are */
+#define RM_RLE_REPEAT               0x80    /* 0x80-0xFE: the next byte repeated control - 0x80 + 3 times */
+#define RM_RLE_REPEAT_MIN           3
+#define RM_RLE_REPEAT_MAX           (0xFE - RM_RLE_REPEAT + RM_RLE_REPEAT_MIN)
+#define RM_RLE_LONG_REPEAT          0xFF    /* count(2) and the byte follow */
+/* The consumed header of a response is 2 bytes */
+typedef char RM_CompressScanSizeCheck[(RM_COMPRESS_SCAN_SIZE <= 0xFFFF) ? 1 : -1];
+
+/* Definitions of SetLogTable record */
+#define RM_SETLOG_TABLE_RECORD_SIZE (1 + 1 + RM_ADDRESS_SIZE)  /* size(1)+count(1)+address */
+
+/* Definitions of registry response */
+#define RM_REGISTRY_HEADER_SIZE     5   /* total(2)+start(2)+count(1) */
+#define RM_REGISTRY_RECORD_SIZE     (1 + 2 + RM_ADDRESS_SIZE + 1)  /* type(1)+size(2)+address+name length(1), name follows */
+
+#ifdef RM_SUPPORT_STATISTICS
+#define RM_STATISTICS_COUNT(counter)    ((counter)++)
+#else
+#define RM_STATISTICS_COUNT(counter)
+#endif
 
 /* Definitions of fixed frame index */
 #define RM_FRAME_SEQCODE        0
 #define RM_FRAME_PAYLOAD        1
 
+/* RM_GetLogData() counts RM_FRAME_PAYLOAD on top of a full payload, the check follows that log frame */
+typedef char RM_SndFrameBuffSizeCheck[(RM_SND_FRAME_BUFF_SIZE >= (1 + RM_FRAME_PAYLOAD + RM_SND_PAYLOAD_SIZE + RM_CHECK_SIZE_MAX)) ? 1 : -1];
+
 
-#ifdef RM_ADDRESS_4BYTE
+#if defined(RM_ADDRESS_8BYTE)
+#define RM_LOGCONTENTS_TABLE_SIZE   29
+#define RM_LOGCONTENTS_DATA_UNIT    9 /* size(1)+address(8) = 9 */
+const uint8_t RM_LogContentsParser[RM_LOGCONTENTS_TABLE_SIZE] =
+{
+    0,                                  /* imaginary-padding */
+    0,                                  /* code */
+    0, 0, 0, 0, 0, 0, 0, 0, 1,          /* size(1) and address(8) */
+    0, 0, 0, 0, 0, 0, 0, 0, 2,          /* size(1) and address(8) */
+    0, 0, 0, 0, 0, 0, 0, 0, 3           /* size(1) and address(8) */
+};
+
+#define RM_WRITECONTENTS_TABLE_SIZE   18
+const uint8_t RM_WriteContentsParser[RM_WRITECONTENTS_TABLE_SIZE] =
+{
+    0,                              /* imaginary-padding */
+    0, 0, 0, 0, 0, 0, 0, 0, 0,      /* size(1) and address(8) */
+    1, 2, 0, 4, 0, 0, 0, 8          /* data length */
+};
+#elif defined(RM_ADDRESS_4BYTE)
 #define RM_LOGCONTENTS_TABLE_SIZE   22
 #define RM_LOGCONTENTS_DATA_UNIT    5 /* size(1)+address(4) = 5 */
 const uint8_t RM_LogContentsParser[RM_LOGCONTENTS_TABLE_SIZE] =
@@ -89,6 +204,105 @@ const uint8_t RM_CrcTable[256] =
     , 0x84, 0x51, 0xfb, 0x2e, 0x7a, 0xaf, 0x05, 0xd0, 0xad, 0x78, 0xd2, 0x07, 0x53, 0x86, 0x2c, 0xf9 /* 0xF0 */
 };
 
+#if defined(RM_SUPPORT_HASH) || defined(RM_SUPPORT_SNAPSHOT) || defined(RM_SUPPORT_SESSION)
+/* CRC-32 (0xEDB88320 reflected), one entry per 4 bits to keep the table small */
+const uint32_t RM_Crc32Table[16] =
+{
+      0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c
+    , 0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+#endif
+
+#ifdef RM_SUPPORT_WIDE_CRC
+#ifdef __AVR__
+/* CRC-32C (0x82F63B78 reflected), one entry per 4 bits. CRC-16 comes from util/crc16.h */
+const uint32_t RM_Crc32cTable[16] =
+{
+      0x00000000, 0x105ec76f, 0x20bd8ede, 0x30e349b1, 0x417b1dbc, 0x5125dad3, 0x61c69362, 0x7198540d
+    , 0x82f63b78, 0x92a8fc17, 0xa24bb5a6, 0xb21572c9, 0xc38d26c4, 0xd3d3e1ab, 0xe330a81a, 0xf36e6f75
+};
+#else
+/* CRC-16/XMODEM (x^16+x^12+x^5+1) */
+const uint16_t RM_Crc16Table[256] =
+{
+      0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7
+    , 0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef
+    , 0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6
+    , 0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de
+    , 0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485
+    , 0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d
+    , 0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4
+    , 0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc
+    , 0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823
+    , 0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b
+    , 0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12
+    , 0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a
+    , 0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41
+    , 0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49
+    , 0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70
+    , 0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78
+    , 0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f
+    , 0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067
+    , 0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e
+    , 0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256
+    , 0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d
+    , 0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405
+    , 0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c
+    , 0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634
+    , 0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab
+    , 0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3
+    , 0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a
+    , 0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92
+    , 0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9
+    , 0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1
+    , 0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8
+    , 0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0
+};
+
+/* CRC-32C (0x82F63B78 reflected), used without SSE4.2 or ARMv8 CRC instructions */
+const uint32_t RM_Crc32cTable[256] =
+{
+      0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c, 0x26a1e7e8, 0xd4ca64eb
+    , 0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b, 0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24
+    , 0x105ec76f, 0xe235446c, 0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384
+    , 0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc, 0xbc267848, 0x4e4dfb4b
+    , 0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a, 0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35
+    , 0xaa64d611, 0x580f5512, 0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa
+    , 0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad, 0x1642ae59, 0xe4292d5a
+    , 0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a, 0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595
+    , 0x417b1dbc, 0xb3109ebf, 0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957
+    , 0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f, 0xed03a29b, 0x1f682198
+    , 0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927, 0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38
+    , 0xdbfc821c, 0x2997011f, 0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7
+    , 0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e, 0x4767748a, 0xb50cf789
+    , 0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859, 0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46
+    , 0x7198540d, 0x83f3d70e, 0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6
+    , 0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de, 0xdde0eb2a, 0x2f8b6829
+    , 0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c, 0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93
+    , 0x082f63b7, 0xfa44e0b4, 0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c
+    , 0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b, 0xb4091bff, 0x466298fc
+    , 0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c, 0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033
+    , 0xa24bb5a6, 0x502036a5, 0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d
+    , 0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975, 0x0e330a81, 0xfc588982
+    , 0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d, 0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622
+    , 0x38cc2a06, 0xcaa7a905, 0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed
+    , 0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8, 0xe52cc12c, 0x1747422f
+    , 0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff, 0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0
+    , 0xd3d3e1ab, 0x21b862a8, 0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540
+    , 0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78, 0x7fab5e8c, 0x8dc0dd8f
+    , 0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee, 0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1
+    , 0x69e9f0d5, 0x9b8273d6, 0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e
+    , 0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69, 0xd5cf889d, 0x27a40b9e
+    , 0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e, 0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+#endif
+#endif
+
+
+
+#ifdef RM_SUPPORT_PROFILING
+RM_ProfileRecord RM_profileRecord[RM_PROFILE_STAGE_NUM];
+#endif
 
 
 /*-- begin: prototype of function --*/
@@ -99,7 +313,8 @@ bool      RM_SetTransmitLogData( RM_contents* pContents );
 
 uint16_t  RM_GetBlockData( RM_Data* pData, RM_TransmittingData* pTransmitData );
 uint16_t  RM_GetLogData( RM_LogInformation* pLogInformation, RM_TransmittingData* pTransmitData );
-uint8_t   RM_GetCRC( uint8_t buffer[], uint8_t bufferSize );
+uint8_t   RM_GatherLogEntry( rm_address_t address, uint8_t size, uint8_t buffer[] );
+uint8_t   RM_GetCRC( uint8_t buffer[], uint16_t bufferSize );
 
 RM_Status RM_SetLogStart( RM_contents* pContents );
 RM_Status RM_SetLogStop( RM_contents* pContents );
@@ -109,6 +324,61 @@ RM_Status RM_SetLogData( RM_contents* pContents );
 RM_Status RM_ValidatePassKey( RM_contents* pContents );
 RM_Status RM_SetDumpData( RM_contents* pContents );
 RM_Status RM_SetBypassFunction( RM_contents* pContents );
+rm_address_t RM_GetAddress( uint8_t buffer[] );
+void      RM_SetAddress( uint8_t buffer[], rm_address_t address );
+RM_Status RM_ReadRegistry( RM_contents* pContents );
+uint16_t  RM_GetRegistryData( RM_contents* pContents, uint8_t payload[] );
+RM_Status RM_SetExtendedRequest( RM_contents* pContents );
+RM_Status RM_ReadStatistics( RM_contents* pContents );
+RM_Status RM_ReadProfile( RM_contents* pContents );
+RM_Status RM_SetLogTable( RM_contents* pContents );
+RM_Status RM_SaveSession( RM_contents* pContents );
+RM_Status RM_ResumeSession( RM_contents* pContents );
+uint32_t  RM_GetBuildCrc( RM_contents* pContents );
+uint32_t  RM_GetUint32( uint8_t buffer[] );
+RM_Status RM_SelectProfile( RM_contents* pContents );
+RM_Status RM_StoreProfile( RM_contents* pContents );
+RM_Status RM_ListProfiles( RM_contents* pContents );
+uint16_t  RM_GetLogProfileData( RM_contents* pContents, uint8_t payload[] );
+RM_Status RM_SetTrigger( RM_contents* pContents );
+RM_Status RM_ReadCapture( RM_contents* pContents );
+uint16_t  RM_GetCaptureData( RM_contents* pContents, uint8_t payload[] );
+void      RM_RunTrigger( RM_contents* pContents );
+bool      RM_EvaluateTrigger( RM_Trigger* pTrigger );
+uint32_t  RM_ReadValue( rm_address_t address, uint8_t size );
+int8_t    RM_CompareValue( uint8_t type, uint8_t size, uint32_t value, uint32_t threshold );
+float     RM_GetFloatValue( uint8_t type, uint8_t size, uint32_t value );
+void      RM_SetUint32( uint8_t buffer[], uint32_t value );
+RM_Status RM_SetLogMode( RM_contents* pContents );
+void      RM_FoldAggregate( RM_contents* pContents );
+uint16_t  RM_GetAggregateData( RM_contents* pContents, uint8_t payload[] );
+uint16_t  RM_GetScheduledLogData( RM_contents* pContents, uint8_t payload[] );
+uint16_t  RM_GetChangedLogData( RM_contents* pContents, uint8_t payload[] );
+bool      RM_IsLogEntryChanged( RM_ChangeFilter* pFilter, uint8_t size, uint32_t value );
+uint32_t  RM_ExtendSign( uint8_t size, uint32_t value );
+RM_Status RM_HashRegion( RM_contents* pContents );
+RM_Status RM_ReadHash( RM_contents* pContents );
+uint16_t  RM_GetHashData( RM_contents* pContents, uint8_t payload[] );
+void      RM_RunHash( RM_contents* pContents );
+uint32_t  RM_UpdateCRC32( uint32_t crc, const uint8_t buffer[], rm_address_t bufferSize );
+RM_Status RM_TakeSnapshot( RM_contents* pContents );
+RM_Status RM_ReadDiff( RM_contents* pContents );
+uint16_t  RM_GetDiffData( RM_contents* pContents, uint8_t payload[] );
+RM_Status RM_SetCompressedDump( RM_contents* pContents );
+uint16_t  RM_GetCompressedData( RM_contents* pContents, uint8_t payload[] );
+void      RM_RunBypass( RM_contents* pContents );
+uint8_t   RM_VerifyCheck( RM_contents* pContents );
+uint16_t  RM_AppendCheck( RM_contents* pContents, uint16_t frameSize );
+uint16_t  RM_GetCRC16( const uint8_t buffer[], uint16_t bufferSize );
+uint32_t  RM_GetCRC32C( const uint8_t buffer[], uint16_t bufferSize );
+uint32_t  RM_UpdateCRC32CHardware( uint32_t crc, const uint8_t buffer[], uint16_t bufferSize );
+RM_Status RM_DeferBypass( RM_contents* pContents );
+bool      RM_IsCommandWaiting( RM_contents* pContents );
+RM_Status RM_RunCommand( RM_contents* pContents, rm_command_function_t command );
+uint16_t  RM_GetCommandData( RM_contents* pContents, uint8_t payload[] );
+RM_Status RM_SetFraming( RM_contents* pContents );
+void      RM_DecodeCobsData( RM_ReceivedData* pReceivedData, uint8_t data );
+bool      RM_EncodeCobsData( RM_TransmittingData* pTransmitData, uint8_t* pData );
 
 /*-- begin: functions --*/
 
@@ -123,11 +393,7 @@ RM_Status RM_SetBypassFunction( RM_contents* pContents );
  */
 void RM_Initialize( RM_contents* obj, uint8_t version[], uint16_t versionSize, uint16_t millisCount, uint32_t passkey )
 {
-#ifdef RM_ADDRESS_4BYTE
-    obj->versionInfo.address = (uint32_t)version;
-#else
-    obj->versionInfo.address = (uint16_t)version;
-#endif
+    obj->versionInfo.address = (rm_address_t)(uintptr_t)version;
     obj->versionInfo.length = versionSize;
 
     obj->millisCnt = millisCount;
@@ -144,6 +410,61 @@ void RM_Initialize( RM_contents* obj, uint8_t version[], uint16_t versionSize, u
     obj->slvCnt = 0x01;  // initial slv_cnt is "0xX1"
 
     obj->bypassFunction = RM_BYPASS_FUNC_NULL;
+    obj->responseFunction = RM_RESPONSE_FUNC_NULL;
+
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+    obj->bypassState = RM_BYPASS_STATE_IDLE;
+#endif
+
+#ifdef RM_SUPPORT_COMMAND_TABLE
+    obj->command = (const rm_command_function_t*)0;
+    obj->commandCount = 0;
+#endif
+
+#ifdef RM_SUPPORT_REGISTRY
+    obj->registry = (const RM_RegistryEntry*)0;
+    obj->registryCount = 0;
+    obj->registryIndex = 0;
+#endif
+
+#ifdef RM_SUPPORT_ACCESS_CHECK
+    obj->accessRegion = (const RM_AccessRegion*)0;
+    obj->accessRegionCount = 0;
+#endif
+
+#ifdef RM_SUPPORT_SESSION
+    obj->saveFunction = RM_STORAGE_FUNC_NULL;
+    obj->loadFunction = RM_STORAGE_FUNC_NULL;
+    obj->buildId = (const uint8_t*)0;
+    obj->buildIdSize = 0;
+#endif
+
+#ifdef RM_SUPPORT_LOG_PROFILE
+    obj->logProfile = (const RM_LogProfile*)0;
+    obj->logProfileCount = 0;
+    obj->logProfileIndex = 0;
+    memset(obj->logProfileSlot, 0, sizeof(obj->logProfileSlot));
+#endif
+
+#ifdef RM_SUPPORT_TRIGGER
+    obj->trigger.state = RM_TRIGGER_STATE_IDLE;
+    obj->trigger.conditionCount = 0;
+#endif
+
+    obj->logMode = RM_LOG_MODE_SAMPLE;
+#ifdef RM_SUPPORT_AGGREGATION
+    obj->aggregateCount = 0;
+#endif
+#ifdef RM_SUPPORT_HASH
+    obj->hash.state = RM_HASH_STATE_IDLE;
+#endif
+#ifdef RM_SUPPORT_SNAPSHOT
+    obj->snapshot.length = 0;
+#endif
+#ifdef RM_SUPPORT_SCHEDULE
+    obj->logScheduleLength = 1;
+    obj->logScheduleId = 0;
+#endif
 
     obj->log.currentIndex = 0;
     obj->log.availableIndex = 0;
@@ -151,11 +472,25 @@ void RM_Initialize( RM_contents* obj, uint8_t version[], uint16_t versionSize, u
     obj->rxData.timeoutCnt = 0;
     obj->rxData.length = 0;
     obj->rxData.status = RM_RECEIVED_STATUS_READY;
+#ifdef RM_SUPPORT_STATISTICS
+    obj->rxData.purgedCnt = 0;
+    memset(&obj->statistics, 0, sizeof(obj->statistics));
+#endif
 
     obj->txData.currentIndex = 0;
     obj->txData.maxIndex = 0;
     obj->txData.status = RM_TRANSMIT_STATUS_COMPLETE;
 
+#ifdef RM_SUPPORT_WIDE_CRC
+    obj->frameCheck = RM_FRAME_CHECK_CRC8;
+#endif
+
+#ifdef RM_SUPPORT_COBS
+    obj->rxData.framing = RM_FRAMING_DEFAULT;
+    obj->txData.framing = RM_FRAMING_DEFAULT;
+    obj->framingTimeoutCnt = 0;
+#endif
+
 }
 
 /** 
@@ -169,22 +504,29 @@ void RM_Task( RM_contents* obj )
     RM_Status result;
     uint8_t opcode;
     uint8_t master_count;
-    uint8_t crc;
+    uint8_t check_size;
+    RM_PROFILE_BEGIN(profile_start);
 
     if( obj->rxData.status == RM_RECEIVED_STATUS_BUSY_NORMAL || obj->rxData.status == RM_RECEIVED_STATUS_BUSY_ESCAPE )
     {
         obj->rxData.timeoutCnt += obj->millisCnt;
         if( obj->rxData.timeoutCnt >= RM_RCV_TIMEOUT_CNT )
         {
+            RM_STATISTICS_COUNT(obj->statistics.rxTimeouts);
             RM_ClearReceivedState(&obj->rxData);
         }
     }
-    else if( obj->rxData.status == RM_RECEIVED_STATUS_COMPLETE && obj->isRequestFinished == true )
+    else if( obj->rxData.status == RM_RECEIVED_STATUS_COMPLETE && obj->isRequestFinished == true &&
+             RM_IsCommandWaiting(obj) == false )
     {
-        crc = RM_GetCRC(obj->rxData.buffer, obj->rxData.length);
-        if( crc == 0 )
+        check_size = RM_VerifyCheck(obj);
+        if( check_size != 0 )
         {
-            obj->rxData.length--;     // delete crc data size
+            RM_STATISTICS_COUNT(obj->statistics.framesReceived);
+#ifdef RM_SUPPORT_COBS
+            obj->framingTimeoutCnt = 0;
+#endif
+            obj->rxData.length -= check_size;     // delete crc data size
             opcode = obj->rxData.buffer[RM_FRAME_SEQCODE] & (uint8_t)0x0F;
             master_count = obj->rxData.buffer[RM_FRAME_SEQCODE] & (uint8_t)0xF0;
 
@@ -202,6 +544,10 @@ void RM_Task( RM_contents* obj )
             }
 
         }
+        else
+        {
+            RM_STATISTICS_COUNT(obj->statistics.crcErrors);
+        }
 
         RM_ClearReceivedState(&obj->rxData);
     }
@@ -211,6 +557,31 @@ void RM_Task( RM_contents* obj )
         obj->isRequestFinished = RM_SetTransmitBlockData(obj);
     }
 
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+    RM_RunBypass(obj);
+#endif
+
+#ifdef RM_SUPPORT_COBS
+    if( obj->rxData.framing != RM_FRAMING_DEFAULT )
+    {
+        obj->framingTimeoutCnt += obj->millisCnt;
+        if( (obj->framingTimeoutCnt >= RM_REQ_TIMEOUT_CNT) && (obj->rxData.status == RM_RECEIVED_STATUS_READY) )
+        {
+            /* The host may have restarted, it negotiates again from RM_FRAMING_DEFAULT */
+            obj->framingTimeoutCnt = 0;
+            obj->rxData.framing = RM_FRAMING_DEFAULT;
+        }
+    }
+#endif
+
+#ifdef RM_SUPPORT_TRIGGER
+    RM_RunTrigger(obj);
+#endif
+
+#ifdef RM_SUPPORT_HASH
+    RM_RunHash(obj);
+#endif
+
     if(obj->isLogging == true)
     {
         obj->logTimeoutCnt += obj->millisCnt;
@@ -220,6 +591,13 @@ void RM_Task( RM_contents* obj )
             obj->isLogging = false;
         }
 
+#ifdef RM_SUPPORT_AGGREGATION
+        if( obj->logMode == RM_LOG_MODE_AGGREGATE )
+        {
+            RM_FoldAggregate(obj);
+        }
+#endif
+
         obj->logIntervalCnt += obj->millisCnt;
         if( obj->logIntervalCnt >= obj->logIntervalPeriod )
         {
@@ -229,11 +607,34 @@ void RM_Task( RM_contents* obj )
             {
                 RM_SetTransmitLogData(obj);
             }
+            else
+            {
+                RM_STATISTICS_COUNT(obj->statistics.logSkipped);
+            }
+
+#ifdef RM_SUPPORT_SCHEDULE
+            /* Skipped periods count too, so the rates hold in time */
+            obj->logScheduleId++;
+            if( obj->logScheduleId >= obj->logScheduleLength )
+            {
+                obj->logScheduleId = 0;
+            }
+#endif
 
         }
+#ifdef RM_SUPPORT_CHANGE_LOG
+        else if( (obj->logMode == RM_LOG_MODE_CHANGE) &&
+                 (obj->isRequestFinished == true) &&
+                 (obj->txData.status == RM_TRANSMIT_STATUS_COMPLETE) )
+        {
+            /* Changes wait for a free link, they are still pending at the next tick */
+            RM_SetTransmitLogData(obj);
+        }
+#endif
 
     }
 
+    RM_PROFILE_END(RM_PROFILE_STAGE_TASK, profile_start);
 }
 
 /** 
@@ -263,8 +664,21 @@ void RM_DecodeReceivedData(RM_ReceivedData* pReceivedData, uint8_t  data)
         return;
     }
 
-    if( pReceivedData->length >= RM_RCV_FRAME_BUFF_SIZE )
+    /* RM_RCV_TIMEOUT_CNT limits the gap between bytes, a long frame at a low baud rate is not dropped */
+    pReceivedData->timeoutCnt = 0;
+
+#ifdef RM_SUPPORT_COBS
+    if( pReceivedData->framing == RM_FRAMING_COBS )
+    {
+        RM_DecodeCobsData(pReceivedData, data);
+        return;
+    }
+#endif
+
+    /* A full buffer can still take the closing RM_FRAME_CHAR_END */
+    if( (pReceivedData->length >= RM_RCV_FRAME_BUFF_SIZE) && (data != RM_FRAME_CHAR_END) )
     {
+        RM_STATISTICS_COUNT(pReceivedData->purgedCnt);
         pReceivedData->status = RM_RECEIVED_STATUS_READY;
         pReceivedData->length = 0;
     }
@@ -321,6 +735,7 @@ void RM_DecodeReceivedData(RM_ReceivedData* pReceivedData, uint8_t  data)
         else
         {
             /* Purge received data */
+            RM_STATISTICS_COUNT(pReceivedData->purgedCnt);
             pReceivedData->status = RM_RECEIVED_STATUS_READY;
             pReceivedData->length = 0;
         }
@@ -337,7 +752,6 @@ void RM_DecodeReceivedData(RM_ReceivedData* pReceivedData, uint8_t  data)
  */
 bool RM_SetTransmitBlockData( RM_contents* pContents )
 {
-    uint8_t  crc;
     uint8_t  data_size;
     uint8_t  frame_size;
 
@@ -352,20 +766,32 @@ bool RM_SetTransmitBlockData( RM_contents* pContents )
         pContents->slvCnt = 0x01;
     }
     
-    data_size = RM_GetBlockData( &pContents->block, &pContents->txData );
+    if( pContents->responseFunction != RM_RESPONSE_FUNC_NULL )
+    {
+        data_size = pContents->responseFunction( pContents, &pContents->txData.buffer[RM_FRAME_PAYLOAD] );
+        pContents->responseFunction = RM_RESPONSE_FUNC_NULL;
+    }
+    else
+    {
+        data_size = RM_GetBlockData( &pContents->block, &pContents->txData );
+    }
 
     /* response opcode */
     pContents->txData.buffer[RM_FRAME_SEQCODE] = pContents->masCnt + pContents->slvCnt;
 
     frame_size = 1;
     frame_size += data_size;
-    crc = RM_GetCRC(pContents->txData.buffer, frame_size);
-    pContents->txData.buffer[frame_size] = crc;
-    frame_size++;
+    frame_size = RM_AppendCheck(pContents, frame_size);
+
+#ifdef RM_SUPPORT_COBS
+    /* A framing change takes effect with its own response, log frames follow it */
+    pContents->txData.framing = pContents->rxData.framing;
+#endif
 
     pContents->txData.currentIndex = 0;
     pContents->txData.maxIndex = frame_size;
     pContents->txData.status = RM_TRANSMIT_STATUS_READY;
+    RM_STATISTICS_COUNT(pContents->statistics.framesSent);
 
     return true;
 }
@@ -379,40 +805,72 @@ bool RM_SetTransmitBlockData( RM_contents* pContents )
  */
 bool RM_SetTransmitLogData( RM_contents* pContents )
 {
-    uint8_t  crc;
     uint8_t  data_size;
     uint8_t  frame_size;
+    uint8_t  slv_cnt;
 
-    pContents->slvCnt++;
-    if( pContents->slvCnt > 0x0F )
+    slv_cnt = pContents->slvCnt + 1;
+    if( slv_cnt > 0x0F )
     {
-        pContents->slvCnt = 0x01;
+        slv_cnt = 0x01;
     }
 
     if(pContents->txData.status != RM_TRANSMIT_STATUS_COMPLETE)
     {
+        RM_STATISTICS_COUNT(pContents->statistics.logSkipped);
+        /* A skipped sample shows as a gap in the sequence, a change is only sent with the next frame */
+#ifdef RM_SUPPORT_CHANGE_LOG
+        if( pContents->logMode != RM_LOG_MODE_CHANGE )
+#endif
+        {
+            pContents->slvCnt = slv_cnt;
+        }
         return false;
     }
 
-    data_size = RM_GetLogData( &pContents->log, &pContents->txData );
+#ifdef RM_SUPPORT_AGGREGATION
+    if( pContents->logMode == RM_LOG_MODE_AGGREGATE )
+    {
+        data_size = RM_GetAggregateData( pContents, &pContents->txData.buffer[RM_FRAME_PAYLOAD] );
+    }
+    else
+#endif
+#ifdef RM_SUPPORT_SCHEDULE
+    if( pContents->logMode == RM_LOG_MODE_SCHEDULE )
+    {
+        data_size = RM_GetScheduledLogData( pContents, &pContents->txData.buffer[RM_FRAME_PAYLOAD] );
+    }
+    else
+#endif
+#ifdef RM_SUPPORT_CHANGE_LOG
+    if( pContents->logMode == RM_LOG_MODE_CHANGE )
+    {
+        data_size = RM_GetChangedLogData( pContents, &pContents->txData.buffer[RM_FRAME_PAYLOAD] );
+    }
+    else
+#endif
+    {
+        data_size = RM_GetLogData( &pContents->log, &pContents->txData );
+    }
 
+    /* A tick without a frame, such as one without changes, does not use up a sequence code */
     if( data_size == 0 )
     {
         return false;
     }
 
     /* response opcode */
+    pContents->slvCnt = slv_cnt;
     pContents->txData.buffer[RM_FRAME_SEQCODE] = pContents->masCnt + pContents->slvCnt;
 
     frame_size = 1;
     frame_size += data_size;
-    crc = RM_GetCRC(pContents->txData.buffer, frame_size);
-    pContents->txData.buffer[frame_size] = crc;
-    frame_size++;
+    frame_size = RM_AppendCheck(pContents, frame_size);
 
     pContents->txData.currentIndex = 0;
     pContents->txData.maxIndex = frame_size;
     pContents->txData.status = RM_TRANSMIT_STATUS_READY;
+    RM_STATISTICS_COUNT(pContents->statistics.framesSent);
 
     return true;
 }
@@ -430,6 +888,7 @@ RM_Status RM_AnalyzeReceivedFrame( RM_contents* pContents, uint8_t opcode)
     RM_Status result;
 
     result = RM_STATUS_ERR;
+    pContents->responseFunction = RM_RESPONSE_FUNC_NULL;
 
     if( pContents->isApproved == false )
     {
@@ -438,6 +897,13 @@ RM_Status RM_AnalyzeReceivedFrame( RM_contents* pContents, uint8_t opcode)
             /* Try connecting */
             result = RM_ValidatePassKey( pContents );
         }
+        else if( (opcode == RM_OPCODE_EXTENDED) &&
+                 (pContents->rxData.length >= (1 + 1)) &&
+                 (pContents->rxData.buffer[RM_FRAME_PAYLOAD + 0] == RM_EXTCODE_RESUME_SESSION) )
+        {
+            /* Try resuming, the token stands for the passkey */
+            result = RM_ResumeSession( pContents );
+        }
 
     }
     else
@@ -476,6 +942,10 @@ RM_Status RM_AnalyzeReceivedFrame( RM_contents* pContents, uint8_t opcode)
             result = RM_SetBypassFunction( pContents );
             break;
 
+        case RM_OPCODE_EXTENDED:
+            result = RM_SetExtendedRequest( pContents );
+            break;
+
         default:
             break;
         }
@@ -585,11 +1055,7 @@ RM_Status RM_SetLogPeriod( RM_contents* pContents )
  */
 RM_Status RM_WriteValue( RM_contents* pContents )
 {
-#ifdef RM_ADDRESS_4BYTE
-    uint32_t address;
-#else
-    uint16_t address;
-#endif
+    rm_address_t address;
 
     uint16_t offset_index;
 
@@ -610,7 +1076,7 @@ RM_Status RM_WriteValue( RM_contents* pContents )
 #endif
 
     uint16_t available_size = pContents->rxData.length - 1;
-    if( (available_size > RM_WRITECONTENTS_TABLE_SIZE) ||
+    if( (available_size >= RM_WRITECONTENTS_TABLE_SIZE) ||
         (available_size == 0 ) )
     {
         return RM_STATUS_ERR;
@@ -623,32 +1089,20 @@ RM_Status RM_WriteValue( RM_contents* pContents )
         return RM_STATUS_ERR;
     }
 
-#ifdef RM_ADDRESS_4BYTE
-    address  = (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 4];
-    address  = address << 8;
-    address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 3];
-    address  = address << 8;
-    address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2];
-    address  = address << 8;
-    address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
-
-    offset_index = 5;
+    address = RM_GetAddress(&pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1]);
+    offset_index = 1 + RM_ADDRESS_SIZE;
 
-#else
-    address  = (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2];
-    address  = address << 8;
-    address |= (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
-
-    offset_index = 3;
-
-#endif
+    if( RM_IsAccessible(pContents, address, size, RM_ACCESS_WRITE) == false )
+    {
+        return RM_STATUS_ERR;
+    }
 
     switch( size )
     {
     case 1:
         data_8bit = pContents->rxData.buffer[RM_FRAME_PAYLOAD + offset_index];
 
-        ptr_8bit = (uint8_t*)address;
+        ptr_8bit = (uint8_t*)(uintptr_t)address;
         *ptr_8bit = data_8bit;
 
         break;
@@ -658,7 +1112,7 @@ RM_Status RM_WriteValue( RM_contents* pContents )
         data_16bit  = data_16bit << 8;
         data_16bit |= (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + offset_index];
 
-        ptr_16bit = (uint16_t*)address;
+        ptr_16bit = (uint16_t*)(uintptr_t)address;
         *ptr_16bit = data_16bit;
 
         break;
@@ -672,7 +1126,7 @@ RM_Status RM_WriteValue( RM_contents* pContents )
         data_32bit  = data_32bit << 8;
         data_32bit |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + offset_index];
 
-        ptr_32bit = (uint32_t*)address;
+        ptr_32bit = (uint32_t*)(uintptr_t)address;
         *ptr_32bit = data_32bit;
 
         break;
@@ -695,7 +1149,7 @@ RM_Status RM_WriteValue( RM_contents* pContents )
         data_64bit  = data_64bit << 8;
         data_64bit |= (uint64_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + offset_index];
 
-        ptr_64bit = (uint64_t*)address;
+        ptr_64bit = (uint64_t*)(uintptr_t)address;
         *ptr_64bit = data_64bit;
 
         break;
@@ -728,11 +1182,7 @@ RM_Status RM_WriteValue( RM_contents* pContents )
  */
 RM_Status RM_SetLogData( RM_contents* pContents )
 {
-#ifdef RM_ADDRESS_4BYTE
-    uint32_t address;
-#else
-    uint16_t address;
-#endif
+    rm_address_t address;
     uint8_t  size;
     uint16_t total_size;
     uint16_t base_index;
@@ -741,7 +1191,7 @@ RM_Status RM_SetLogData( RM_contents* pContents )
     uint16_t max_index;
 
     uint16_t available_size = pContents->rxData.length - 1;
-    if( (available_size > RM_LOGCONTENTS_TABLE_SIZE) ||
+    if( (available_size >= RM_LOGCONTENTS_TABLE_SIZE) ||
         (available_size == 0 ) )
     {
         goto RM_LABEL_SETLOG_FAILED;
@@ -785,21 +1235,14 @@ RM_Status RM_SetLogData( RM_contents* pContents )
 
         pContents->log.sizeArray[pContents->log.currentIndex] = size;
 
-#ifdef RM_ADDRESS_4BYTE
-        address  = (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + base_index+4];
-        address  = address << 8;
-        address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + base_index+3];
-        address  = address << 8;
-        address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + base_index+2];
-        address  = address << 8;
-        address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + base_index+1];
+        address = RM_GetAddress(&pContents->rxData.buffer[RM_FRAME_PAYLOAD + base_index+1]);
 
-#else
-        address  = (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + base_index+2];
-        address  = address << 8;
-        address |= (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + base_index+1];
+        /* Checked once here, so RM_GatherLogData() samples without any check */
+        if( RM_IsAccessible(pContents, address, size, RM_ACCESS_READ) == false )
+        {
+            goto RM_LABEL_SETLOG_FAILED;
+        }
 
-#endif
         pContents->log.addressArray[pContents->log.currentIndex] = address;
         pContents->log.currentIndex++;
     }
@@ -825,6 +1268,7 @@ RM_LABEL_SETLOG_SUCCESS:
     pContents->block.address = 0;
     pContents->block.length = 0;
     pContents->isLogging = false;
+    pContents->logMode = RM_LOG_MODE_SAMPLE;
     
     return RM_STATUS_SUCCESS;
 
@@ -835,6 +1279,7 @@ RM_LABEL_SETLOG_FAILED:
     pContents->block.address = 0;
     pContents->block.length = 0;
     pContents->isLogging = false;
+    pContents->logMode = RM_LOG_MODE_SAMPLE;
 
     return RM_STATUS_ERR;
 }
@@ -850,15 +1295,17 @@ RM_LABEL_SETLOG_FAILED:
  */
 RM_Status RM_ValidatePassKey( RM_contents* pContents )
 {
-#ifdef RM_ADDRESS_4BYTE
-    uint32_t address;
-#else
-    uint16_t address;
-#endif
+    rm_address_t address;
     uint16_t length;
     uint32_t passkey;
 
+#ifdef RM_SUPPORT_WIDE_CRC
+    /* An optional byte after the passkey chooses the RM_FrameCheck from the response on */
+    pContents->frameCheck = RM_FRAME_CHECK_CRC8;
+    if( (pContents->rxData.length != (1 + 4)) && (pContents->rxData.length != (1 + 4 + 1)) )
+#else
     if( pContents->rxData.length != (1 + 4))
+#endif
     {
         pContents->isApproved = false;
         return RM_STATUS_ERR;
@@ -878,6 +1325,19 @@ RM_Status RM_ValidatePassKey( RM_contents* pContents )
         return RM_STATUS_ERR;
     }
 
+#ifdef RM_SUPPORT_WIDE_CRC
+    if( pContents->rxData.length == (1 + 4 + 1) )
+    {
+        if( pContents->rxData.buffer[RM_FRAME_PAYLOAD + 4] > RM_FRAME_CHECK_CRC32C )
+        {
+            pContents->isApproved = false;
+            return RM_STATUS_ERR;
+        }
+
+        pContents->frameCheck = pContents->rxData.buffer[RM_FRAME_PAYLOAD + 4];
+    }
+#endif
+
     address = pContents->versionInfo.address;
     length = pContents->versionInfo.length;
 
@@ -905,45 +1365,24 @@ RM_Status RM_ValidatePassKey( RM_contents* pContents )
  */
 RM_Status RM_SetDumpData( RM_contents* pContents )
 {
-#ifdef RM_ADDRESS_4BYTE
-    uint32_t address;
+    rm_address_t address;
     uint16_t length;
 
     uint16_t available_size = pContents->rxData.length - 1;
-    if(available_size != 5)
+    if(available_size != (RM_ADDRESS_SIZE + 1))
     {
         return RM_STATUS_ERR;
     }
 
-    length = pContents->rxData.buffer[RM_FRAME_PAYLOAD + 4];
-
-    address  = (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 3];
-    address  = address << 8;
-    address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2];
-    address  = address << 8;
-    address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
-    address  = address << 8;
-    address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD];
-
-#else
-    uint16_t address;
-    uint16_t length;
+    length = pContents->rxData.buffer[RM_FRAME_PAYLOAD + RM_ADDRESS_SIZE];
+    address = RM_GetAddress(&pContents->rxData.buffer[RM_FRAME_PAYLOAD]);
 
-    uint16_t available_size = pContents->rxData.length - 1;
-    if(available_size != 3)
+    if(length > RM_SND_PAYLOAD_SIZE)
     {
         return RM_STATUS_ERR;
     }
 
-    length = pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2];
-
-    address  = (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
-    address  = address << 8;
-    address |= (uint32_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD];
-
-#endif
-
-    if(length > RM_SND_PAYLOAD_SIZE)
+    if( RM_IsAccessible(pContents, address, length, RM_ACCESS_READ) == false )
     {
         return RM_STATUS_ERR;
     }
@@ -960,26 +1399,55 @@ RM_Status RM_SetDumpData( RM_contents* pContents )
  * @brief Sets a bypass function.
  * 
  * Configures a function to bypass certain standard procedures or checks. This can be used for special operations.
+ * A bypass function that takes long returns RM_STATUS_PENDING instead, and answers later with RM_CompleteBypass().
+ * Logging keeps running in the meantime, and further bypass requests are rejected until the response is sent.
  * 
  * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
  * @return RM_Status indicating the success or failure of the operation.
  */
 RM_Status RM_SetBypassFunction( RM_contents* pContents )
 {
-#ifdef RM_ADDRESS_4BYTE
-    uint32_t address;
-#else
-    uint16_t address;
-#endif
-    uint16_t length;
+    rm_address_t address = 0;
+    uint16_t length = 0;
     RM_BypassResponse response;
     response.status = RM_STATUS_ERR;
 
+#ifdef RM_SUPPORT_COMMAND_TABLE
+    rm_command_function_t command;
+#endif
+
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+    if( pContents->bypassState != RM_BYPASS_STATE_IDLE )
+    {
+        return RM_STATUS_ERR;
+    }
+#endif
+
+#ifdef RM_SUPPORT_COMMAND_TABLE
+    if( (pContents->rxData.length >= (1 + 1)) &&
+        (pContents->rxData.buffer[RM_FRAME_PAYLOAD] < pContents->commandCount) )
+    {
+        RM_FLASH_READ(&command, &pContents->command[pContents->rxData.buffer[RM_FRAME_PAYLOAD]], sizeof(command));
+        if( command != RM_COMMAND_FUNC_NULL )
+        {
+            return RM_RunCommand(pContents, command);
+        }
+    }
+#endif
+
     if( pContents->bypassFunction != RM_BYPASS_FUNC_NULL )
     {
+        RM_STATISTICS_COUNT(pContents->statistics.bypassCalls);
         response = pContents->bypassFunction( &pContents->rxData.buffer[RM_FRAME_PAYLOAD], (pContents->rxData.length - 1) );
 
-        address = (uint32_t)response.buffer;
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+        if( response.status == RM_STATUS_PENDING )
+        {
+            return RM_DeferBypass(pContents);
+        }
+#endif
+
+        address = (rm_address_t)(uintptr_t)response.buffer;
         length = response.length;
 
         if(length > RM_SND_PAYLOAD_SIZE)
@@ -996,179 +1464,3336 @@ RM_Status RM_SetBypassFunction( RM_contents* pContents )
     return response.status;
 }
 
-/**
- * @fn uint16_t RM_GetLogData( RM_LogInformation* pLogInformation, RM_TransmittingData* pTransmitData )
- * @brief Retrieves log data for transmission.
+#ifdef RM_SUPPORT_COMMAND_TABLE
+/** 
+ * @fn void RM_AttachCommands( RM_contents* obj, const rm_command_function_t table[], uint8_t count )
+ * @brief Attaches the bypass sub-commands, indexed by the first byte of the request.
  * 
- * @param pLogInformation Pointer to RM_LogInformation structure.
- * @param pTransmitData Pointer to RM_TransmittingData structure.
- * @return The size of the log data prepared for transmission.
+ * @param obj Pointer to RM_contents structure.
+ * @param table[] Array of handlers in RM_FLASH, NULL for unused IDs.
+ * @param count Number of entries.
  */
-uint16_t RM_GetLogData( RM_LogInformation* pLogInformation, RM_TransmittingData* pTransmitData )
+void RM_AttachCommands( RM_contents* obj, const rm_command_function_t table[], uint8_t count )
 {
-#ifdef RM_ADDRESS_4BYTE
-    uint32_t address;
-#else
-    uint16_t address;
+    obj->command = table;
+    obj->commandCount = count;
+}
 #endif
-    uint16_t index;
-    uint16_t payload_index;
 
-    uint8_t  data_8bit;
-    uint8_t* ptr_8bit;
+/** 
+ * @fn bool RM_IsCommandWaiting( RM_contents* pContents )
+ * @brief Checks if the received frame is a sub-command that has to wait for the transmitter.
+ * 
+ * Sub-commands write their response into RM_contents::txData directly, so they run only
+ * while no frame is being sent.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @return true if the frame has to stay in the receive buffer, false otherwise.
+ */
+bool RM_IsCommandWaiting( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_COMMAND_TABLE
+    return (pContents->txData.status != RM_TRANSMIT_STATUS_COMPLETE) &&
+           (pContents->isApproved == true) &&
+           ((pContents->rxData.buffer[RM_FRAME_SEQCODE] & (uint8_t)0x0F) == 0x08) &&
+           (pContents->rxData.length >= (1 + 1 + 1)) &&
+           (pContents->rxData.buffer[RM_FRAME_PAYLOAD] < pContents->commandCount);
+#else
+    (void)pContents;
+    return false;
+#endif
+}
 
-    uint16_t  data_16bit;
-    uint16_t* ptr_16bit;
+/** 
+ * @fn RM_Status RM_RunCommand( RM_contents* pContents, rm_command_function_t command )
+ * @brief Runs a bypass sub-command, which writes its response into the transmit payload.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param command Handler of the sub-command.
+ * @return RM_Status returned by the handler.
+ */
+RM_Status RM_RunCommand( RM_contents* pContents, rm_command_function_t command )
+{
+#ifdef RM_SUPPORT_COMMAND_TABLE
+    RM_Status status;
+    uint16_t length;
 
-    uint32_t  data_32bit;
-    uint32_t* ptr_32bit;
+    RM_STATISTICS_COUNT(pContents->statistics.bypassCalls);
 
-#ifdef RM_SUPPORT_64BIT
-    uint64_t  data_64bit;
-    uint64_t* ptr_64bit;
-#endif
+    length = 0;
+    status = command( &pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1], (pContents->rxData.length - 1 - 1),
+                      &pContents->txData.buffer[RM_FRAME_PAYLOAD], &length );
 
-    if(pLogInformation->availableIndex == 0)
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+    if( status == RM_STATUS_PENDING )
     {
-        return 0;
+        return RM_DeferBypass(pContents);
     }
+#endif
 
-    payload_index = RM_FRAME_PAYLOAD;
-    for( index = 0; index < pLogInformation->availableIndex; index++ )
+    if( status == RM_STATUS_SUCCESS )
     {
-        address = pLogInformation->addressArray[index];
-
-        switch( pLogInformation->sizeArray[index] )
+        if( length > RM_SND_PAYLOAD_SIZE )
         {
-        case 1:
-            ptr_8bit = (uint8_t*)address;
-            data_8bit = *ptr_8bit;
-
-            pTransmitData->buffer[payload_index] = data_8bit;
-            payload_index++;
-
-            break;
+            length = RM_SND_PAYLOAD_SIZE;
+        }
 
-        case 2:
-            ptr_16bit = (uint16_t*)address;
-            data_16bit = *ptr_16bit;
+        /* RM_GetCommandData() sends what the handler wrote */
+        pContents->block.length = length;
+        pContents->responseFunction = RM_GetCommandData;
+        pContents->isLogging = false;
+    }
 
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_16bit);
-            payload_index++;
-            data_16bit = data_16bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_16bit);
-            payload_index++;
+    return status;
+#else
+    (void)pContents;
+    (void)command;
+    return RM_STATUS_ERR;
+#endif
+}
 
-            break;
+/**
+ * @fn uint16_t RM_GetCommandData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Returns the size of the response a sub-command has written into payload.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes, already filled.
+ * @return The size of the payload.
+ */
+uint16_t RM_GetCommandData( RM_contents* pContents, uint8_t payload[] )
+{
+    (void)payload;
 
-        case 4:
-            ptr_32bit = (uint32_t*)address;
-            data_32bit = *ptr_32bit;
-
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_32bit);
-            payload_index++;
-            data_32bit = data_32bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_32bit);
-            payload_index++;
-            data_32bit = data_32bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_32bit);
-            payload_index++;
-            data_32bit = data_32bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_32bit);
-            payload_index++;
+    return pContents->block.length;
+}
 
-            break;
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+/** 
+ * @fn RM_Status RM_DeferBypass( RM_contents* pContents )
+ * @brief Waits for RM_CompleteBypass() to answer the received bypass request.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @return RM_STATUS_SUCCESS_NR, the request is accepted with no response for now.
+ */
+RM_Status RM_DeferBypass( RM_contents* pContents )
+{
+    /* The response keeps the sequence code of this request, whatever comes in between */
+    pContents->bypassMasCnt = pContents->rxData.buffer[RM_FRAME_SEQCODE] & (uint8_t)0xF0;
+    pContents->bypassState = RM_BYPASS_STATE_PENDING;
 
-#ifdef RM_SUPPORT_64BIT
-        case 8:
-            ptr_64bit = (uint64_t*)address;
-            data_64bit = *ptr_64bit;
-
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_64bit);
-            payload_index++;
-            data_64bit = data_64bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_64bit);
-            payload_index++;
-            data_64bit = data_64bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_64bit);
-            payload_index++;
-            data_64bit = data_64bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_64bit);
-            payload_index++;
-            data_64bit = data_64bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_64bit);
-            payload_index++;
-            data_64bit = data_64bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_64bit);
-            payload_index++;
-            data_64bit = data_64bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_64bit);
-            payload_index++;
-            data_64bit = data_64bit >> 8;
-            pTransmitData->buffer[payload_index] = (uint8_t)(data_64bit);
-            payload_index++;
+    return RM_STATUS_SUCCESS_NR;
+}
 
+/** 
+ * @fn bool RM_CompleteBypass( RM_contents* obj, RM_BypassResponse response )
+ * @brief Completes a bypass request whose function returned RM_STATUS_PENDING.
+ * 
+ * The response is sent by RM_Task() once the transmitter is free, from response.buffer, which has to stay
+ * valid until then. RM_STATUS_ERR and RM_STATUS_SUCCESS_NR send nothing, as for a bypass function.
+ * Call it from the context that calls RM_Task(), the bypass function itself excepted.
+ * 
+ * @param obj Pointer to RM_contents structure.
+ * @param response Response of the bypass request.
+ * @return true if a bypass request was pending, false otherwise.
+ */
+bool RM_CompleteBypass( RM_contents* obj, RM_BypassResponse response )
+{
+    if( obj->bypassState != RM_BYPASS_STATE_PENDING )
+    {
+        return false;
+    }
+
+    obj->bypassResponse = response;
+    obj->bypassState = RM_BYPASS_STATE_COMPLETE;
+
+    return true;
+}
+
+/** 
+ * @fn void RM_RunBypass( RM_contents* pContents )
+ * @brief Sends the response passed to RM_CompleteBypass(), once no other response is in progress.
+ * 
+ * Unlike the immediate response of a bypass function, it does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ */
+void RM_RunBypass( RM_contents* pContents )
+{
+    uint16_t master_count;
+
+    if( (pContents->bypassState != RM_BYPASS_STATE_COMPLETE) ||
+        (pContents->isRequestFinished == false) ||
+        (pContents->txData.status != RM_TRANSMIT_STATUS_COMPLETE) )
+    {
+        return;
+    }
+
+    pContents->bypassState = RM_BYPASS_STATE_IDLE;
+
+    if( pContents->bypassResponse.status != RM_STATUS_SUCCESS )
+    {
+        return;
+    }
+
+    pContents->block.address = (rm_address_t)(uintptr_t)pContents->bypassResponse.buffer;
+    pContents->block.length = pContents->bypassResponse.length;
+    if( pContents->block.length > RM_SND_PAYLOAD_SIZE )
+    {
+        pContents->block.length = RM_SND_PAYLOAD_SIZE;
+    }
+
+    master_count = pContents->masCnt;
+    pContents->masCnt = pContents->bypassMasCnt;
+    pContents->responseFunction = RM_RESPONSE_FUNC_NULL;
+    RM_SetTransmitBlockData(pContents);
+    pContents->masCnt = master_count;
+}
+#endif
+
+/** 
+ * @fn RM_Status RM_SetExtendedRequest( RM_contents* pContents )
+ * @brief Dispatches an extended request.
+ * 
+ * The opcode field of a frame has only 4 bits, so requests added after RM_SetBypassFunction()
+ * share RM_OPCODE_EXTENDED and are selected by the first payload byte.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_SetExtendedRequest( RM_contents* pContents )
+{
+    RM_Status result;
+
+    result = RM_STATUS_ERR;
+
+    if( pContents->rxData.length < (1 + 1) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    switch( pContents->rxData.buffer[RM_FRAME_PAYLOAD + 0] )
+    {
+    case RM_EXTCODE_STATISTICS:
+        result = RM_ReadStatistics( pContents );
+        break;
+
+    case RM_EXTCODE_PROFILE:
+        result = RM_ReadProfile( pContents );
+        break;
+
+    case RM_EXTCODE_REGISTRY:
+        result = RM_ReadRegistry( pContents );
+        break;
+
+    case RM_EXTCODE_SETLOG_TABLE:
+        result = RM_SetLogTable( pContents );
+        break;
+
+    case RM_EXTCODE_SAVE_SESSION:
+        result = RM_SaveSession( pContents );
+        break;
+
+    case RM_EXTCODE_RESUME_SESSION:
+        result = RM_ResumeSession( pContents );
+        break;
+
+    case RM_EXTCODE_SELECT_PROFILE:
+        result = RM_SelectProfile( pContents );
+        break;
+
+    case RM_EXTCODE_STORE_PROFILE:
+        result = RM_StoreProfile( pContents );
+        break;
+
+    case RM_EXTCODE_LIST_PROFILES:
+        result = RM_ListProfiles( pContents );
+        break;
+
+    case RM_EXTCODE_SET_TRIGGER:
+        result = RM_SetTrigger( pContents );
+        break;
+
+    case RM_EXTCODE_READ_CAPTURE:
+        result = RM_ReadCapture( pContents );
+        break;
+
+    case RM_EXTCODE_SET_LOG_MODE:
+        result = RM_SetLogMode( pContents );
+        break;
+
+    case RM_EXTCODE_HASH_REGION:
+        result = RM_HashRegion( pContents );
+        break;
+
+    case RM_EXTCODE_READ_HASH:
+        result = RM_ReadHash( pContents );
+        break;
+
+    case RM_EXTCODE_SNAPSHOT:
+        result = RM_TakeSnapshot( pContents );
+        break;
+
+    case RM_EXTCODE_READ_DIFF:
+        result = RM_ReadDiff( pContents );
+        break;
+
+    case RM_EXTCODE_COMPRESSED_DUMP:
+        result = RM_SetCompressedDump( pContents );
+        break;
+
+    case RM_EXTCODE_SET_FRAMING:
+        result = RM_SetFraming( pContents );
+        break;
+
+    default:
+        break;
+    }
+
+    return result;
+}
+
+/** 
+ * @fn RM_Status RM_ReadStatistics( RM_contents* pContents )
+ * @brief Responds with the link counters.
+ * 
+ * This request is read-only and does not stop logging, so it can be used while streaming.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_ReadStatistics( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_STATISTICS
+    if( pContents->rxData.length != (1 + 1) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    pContents->statistics.escapePurges = pContents->rxData.purgedCnt;
+
+    pContents->block.address = (rm_address_t)(uintptr_t)&pContents->statistics;
+    pContents->block.length = sizeof(pContents->statistics);
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_ReadProfile( RM_contents* pContents )
+ * @brief Responds with the RM_ProfileRecord of the requested stage.
+ * 
+ * This request is read-only and does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_ReadProfile( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_PROFILING
+    uint8_t stage;
+
+    if( pContents->rxData.length != (1 + 2) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    stage = pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
+    if( stage >= RM_PROFILE_STAGE_NUM )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    pContents->block.address = (rm_address_t)(uintptr_t)&RM_profileRecord[stage];
+    pContents->block.length = sizeof(RM_profileRecord[stage]);
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_ReadRegistry( RM_contents* pContents )
+ * @brief Responds with the variable registry, starting at the requested entry.
+ * 
+ * Request payload: code, start index(2). The response holds as many entries as fit, the host
+ * repeats the request from start + count until it reaches total. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_ReadRegistry( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_REGISTRY
+    uint16_t start;
+
+    if( pContents->rxData.length != (1 + 3) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    start  = (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2];
+    start  = start << 8;
+    start |= (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
+
+    if( start > pContents->registryCount )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    pContents->registryIndex = start;
+    pContents->responseFunction = RM_GetRegistryData;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_SetLogTable( RM_contents* pContents )
+ * @brief Replaces the whole log table with a single request.
+ * 
+ * Request payload: code, then records of size(1), count(1), address. A record stands for count
+ * consecutive entries of size bytes starting at address, so an array takes one record. The frame is
+ * checked completely before the table is replaced, a rejected frame leaves the previous table in place.
+ * Logging stops as with RM_SetLogData().
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_SetLogTable( RM_contents* pContents )
+{
+    rm_address_t address;
+    uint16_t available_size;
+    uint16_t base_index;
+    uint16_t entry_count;
+    uint16_t total_size;
+    uint16_t index;
+    uint8_t  size;
+    uint8_t  count;
+
+    available_size = pContents->rxData.length - 1 - 1;
+    if( (available_size == 0) ||
+        ((available_size % RM_SETLOG_TABLE_RECORD_SIZE) != 0) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    entry_count = 0;
+    total_size = 0;
+    for( base_index = RM_FRAME_PAYLOAD + 1; base_index < pContents->rxData.length; base_index += RM_SETLOG_TABLE_RECORD_SIZE )
+    {
+        size = pContents->rxData.buffer[base_index];
+        count = pContents->rxData.buffer[base_index + 1];
+        address = RM_GetAddress(&pContents->rxData.buffer[base_index + 2]);
+
+#ifdef RM_SUPPORT_64BIT
+        if( (size != 1) && (size != 2) && (size != 4) && (size != 8) )
+#else
+        if( (size != 1) && (size != 2) && (size != 4) )
+#endif
+        {
+            return RM_STATUS_ERR;
+        }
+
+        entry_count += count;
+        total_size += (uint16_t)size * count;
+        if( (count == 0) ||
+            (entry_count > RM_LOG_FACTOR_MAX) ||
+            (total_size > RM_SND_PAYLOAD_SIZE) )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        if( RM_IsAccessible(pContents, address, (uint16_t)size * count, RM_ACCESS_READ) == false )
+        {
+            return RM_STATUS_ERR;
+        }
+    }
+
+    entry_count = 0;
+    for( base_index = RM_FRAME_PAYLOAD + 1; base_index < pContents->rxData.length; base_index += RM_SETLOG_TABLE_RECORD_SIZE )
+    {
+        size = pContents->rxData.buffer[base_index];
+        count = pContents->rxData.buffer[base_index + 1];
+        address = RM_GetAddress(&pContents->rxData.buffer[base_index + 2]);
+
+        for( index = 0; index < count; index++ )
+        {
+            pContents->log.sizeArray[entry_count] = size;
+            pContents->log.addressArray[entry_count] = address;
+            address += size;
+            entry_count++;
+        }
+    }
+
+    pContents->log.currentIndex = entry_count;
+    pContents->log.availableIndex = entry_count;
+    pContents->logMode = RM_LOG_MODE_SAMPLE;
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+    pContents->isLogging = false;
+
+    return RM_STATUS_SUCCESS;
+}
+
+/** 
+ * @fn RM_Status RM_SaveSession( RM_contents* pContents )
+ * @brief Saves the log table and period through the storage hook.
+ * 
+ * Request payload: code, token(4). After a reset or RM_REQ_TIMEOUT_CNT the host sends
+ * RM_EXTCODE_RESUME_SESSION with the same token instead of the passkey, log table and period.
+ * This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_SaveSession( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_SESSION
+    RM_SessionRecord record;
+
+    if( (pContents->rxData.length != (1 + 5)) ||
+        (pContents->saveFunction == RM_STORAGE_FUNC_NULL) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    /* Padding bytes are stored as well, keep them constant */
+    memset(&record, 0, sizeof(record));
+    record.token = RM_GetUint32(&pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1]);
+    if( record.token == 0 )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    record.logIntervalPeriod = pContents->logIntervalPeriod;
+    record.availableIndex = pContents->log.availableIndex;
+    memcpy(record.sizeArray, pContents->log.sizeArray, sizeof(record.sizeArray));
+    memcpy(record.addressArray, pContents->log.addressArray, sizeof(record.addressArray));
+    record.buildCrc = RM_GetBuildCrc(pContents);
+    record.crc = RM_GetCRC((uint8_t*)&record, (uint16_t)offsetof(RM_SessionRecord, crc));
+
+    if( pContents->saveFunction((uint8_t*)&record, sizeof(record)) == false )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+#ifdef RM_SUPPORT_SESSION
+/** 
+ * @fn uint32_t RM_GetBuildCrc( RM_contents* pContents )
+ * @brief Calculates the key tying a RM_SessionRecord to this firmware.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return CRC-32 of the version information followed by the build ID.
+ */
+uint32_t RM_GetBuildCrc( RM_contents* pContents )
+{
+    uint32_t crc;
+
+    crc = RM_UpdateCRC32(0xFFFFFFFFUL, (const uint8_t*)(uintptr_t)pContents->versionInfo.address, pContents->versionInfo.length);
+    crc = RM_UpdateCRC32(crc, pContents->buildId, pContents->buildIdSize);
+
+    return ~crc;
+}
+#endif
+
+/** 
+ * @fn RM_Status RM_ResumeSession( RM_contents* pContents )
+ * @brief Restores the saved log table and period, and starts logging.
+ * 
+ * Request payload: code, token(4). It is accepted before RM_ValidatePassKey() as well, and approves
+ * the connection when the token matches and the record carries the version information and build ID
+ * of this firmware. Without RM_AttachBuildId() a rebuild that keeps the version string passes, so the
+ * entries are checked against the access regions again, as when the host sets them.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_ResumeSession( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_SESSION
+    RM_SessionRecord record;
+    uint16_t total_size;
+    uint16_t index;
+    uint8_t  size;
+
+#ifdef RM_SUPPORT_WIDE_CRC
+    /* The request came with CRC-8 like a passkey, the resumed connection goes on with it */
+    pContents->frameCheck = RM_FRAME_CHECK_CRC8;
+#endif
+
+    if( (pContents->rxData.length != (1 + 5)) ||
+        (pContents->loadFunction == RM_STORAGE_FUNC_NULL) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    if( pContents->loadFunction((uint8_t*)&record, sizeof(record)) == false )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    if( (record.crc != RM_GetCRC((uint8_t*)&record, (uint16_t)offsetof(RM_SessionRecord, crc))) ||
+        (record.token == 0) ||
+        (record.token != RM_GetUint32(&pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1])) ||
+        (record.buildCrc != RM_GetBuildCrc(pContents)) ||
+        (record.logIntervalPeriod == 0) ||
+        (record.availableIndex > RM_LOG_FACTOR_MAX) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    total_size = 0;
+    for( index = 0; index < record.availableIndex; index++ )
+    {
+        size = record.sizeArray[index];
+        total_size += size;
+
+#ifdef RM_SUPPORT_64BIT
+        if( (size != 1) && (size != 2) && (size != 4) && (size != 8) )
+#else
+        if( (size != 1) && (size != 2) && (size != 4) )
+#endif
+        {
+            return RM_STATUS_ERR;
+        }
+
+        if( RM_IsAccessible(pContents, record.addressArray[index], size, RM_ACCESS_READ) == false )
+        {
+            return RM_STATUS_ERR;
+        }
+    }
+
+    if( total_size > RM_SND_PAYLOAD_SIZE )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    memcpy(pContents->log.sizeArray, record.sizeArray, sizeof(record.sizeArray));
+    memcpy(pContents->log.addressArray, record.addressArray, sizeof(record.addressArray));
+    pContents->log.currentIndex = record.availableIndex;
+    pContents->log.availableIndex = record.availableIndex;
+    pContents->logIntervalPeriod = record.logIntervalPeriod;
+    pContents->logMode = RM_LOG_MODE_SAMPLE;
+    pContents->logIntervalCnt = 0;
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+    pContents->isApproved = true;
+    pContents->isLogging = true;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_SelectProfile( RM_contents* pContents )
+ * @brief Makes a log profile the active log table, see RM_SelectLogProfile().
+ * 
+ * Request payload: code, profile index(1). Logging continues, the next log frame already
+ * follows the selected profile.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_SelectProfile( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_LOG_PROFILE
+    if( pContents->rxData.length != (1 + 2) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    if( RM_SelectLogProfile(pContents, pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1]) == false )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_StoreProfile( RM_contents* pContents )
+ * @brief Keeps the active log table and period in a profile slot.
+ * 
+ * Request payload: code, slot(1), name(0 to RM_LOG_PROFILE_NAME_SIZE). The host builds a table once
+ * with RM_SetLogData() or RM_SetLogTable() and stores it, it is selected later by the profile index
+ * RM_contents::logProfileCount + slot. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_StoreProfile( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_LOG_PROFILE
+    RM_LogProfileSlot* slot;
+    uint16_t name_length;
+
+    if( (pContents->rxData.length < (1 + 2)) ||
+        (pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1] >= RM_LOG_PROFILE_SLOT_NUM) ||
+        (pContents->log.availableIndex == 0) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    name_length = pContents->rxData.length - 1 - 2;
+    if( name_length > RM_LOG_PROFILE_NAME_SIZE )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    slot = &pContents->logProfileSlot[pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1]];
+    memset(slot->name, 0, sizeof(slot->name));
+    memcpy(slot->name, &pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2], name_length);
+    slot->logIntervalPeriod = pContents->logIntervalPeriod;
+    slot->log = pContents->log;
+    slot->log.currentIndex = slot->log.availableIndex;
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_ListProfiles( RM_contents* pContents )
+ * @brief Responds with the names of the log profiles, starting at the requested profile.
+ * 
+ * Request payload: code, start index(1). The response holds as many profiles as fit, the host
+ * repeats the request from start + count until it reaches total. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_ListProfiles( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_LOG_PROFILE
+    if( (pContents->rxData.length != (1 + 2)) ||
+        (pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1] > (pContents->logProfileCount + RM_LOG_PROFILE_SLOT_NUM)) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    pContents->logProfileIndex = pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
+    pContents->responseFunction = RM_GetLogProfileData;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_SetTrigger( RM_contents* pContents )
+ * @brief Arms the trigger engine, or disarms it when no condition is given.
+ * 
+ * Request payload: code, combine(1, 0:AND 1:OR), pre samples(2), post samples(2), then up to
+ * RM_TRIGGER_CONDITION_NUM records of kind(1), type << 4 | size(1), address, a(4), b(4).
+ * The samples have the layout of the current log table, which must not change until the capture
+ * is read. A rejected request leaves the previous trigger as it was. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_SetTrigger( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_TRIGGER
+    RM_Trigger* trigger;
+    RM_TriggerCondition conditions[RM_TRIGGER_CONDITION_NUM];
+    RM_TriggerCondition* condition;
+    uint8_t* buffer;
+    uint16_t available_size;
+    uint16_t sample_size;
+    uint16_t pre_samples;
+    uint16_t post_samples;
+    uint16_t count;
+    uint16_t index;
+
+    trigger = &pContents->trigger;
+    buffer = &pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
+
+    available_size = pContents->rxData.length - 1 - 1;
+    if( (available_size < RM_TRIGGER_HEADER_SIZE) ||
+        (((available_size - RM_TRIGGER_HEADER_SIZE) % RM_TRIGGER_RECORD_SIZE) != 0) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    count = (available_size - RM_TRIGGER_HEADER_SIZE) / RM_TRIGGER_RECORD_SIZE;
+    if( count > RM_TRIGGER_CONDITION_NUM )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    if( count == 0 )
+    {
+        trigger->state = RM_TRIGGER_STATE_IDLE;
+        trigger->conditionCount = 0;
+        return RM_STATUS_SUCCESS;
+    }
+
+    pre_samples  = (uint16_t)buffer[2] << 8;
+    pre_samples |= (uint16_t)buffer[1];
+    post_samples  = (uint16_t)buffer[4] << 8;
+    post_samples |= (uint16_t)buffer[3];
+
+    sample_size = 0;
+    for( index = 0; index < pContents->log.availableIndex; index++ )
+    {
+        sample_size += pContents->log.sizeArray[index];
+    }
+
+    /* The ring must hold pre + post samples of the current log table */
+    if( (sample_size == 0) ||
+        (post_samples == 0) ||
+        (((uint32_t)pre_samples + post_samples) * sample_size > RM_TRIGGER_BUFFER_SIZE) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    /* The running trigger is only replaced once every condition is valid */
+    for( index = 0; index < count; index++ )
+    {
+        condition = &conditions[index];
+        buffer = &pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1 + RM_TRIGGER_HEADER_SIZE + index * RM_TRIGGER_RECORD_SIZE];
+
+        condition->kind = buffer[0];
+        condition->type = buffer[1] >> 4;
+        condition->size = buffer[1] & 0x0F;
+        condition->address = RM_GetAddress(&buffer[2]);
+        condition->a = RM_GetUint32(&buffer[2 + RM_ADDRESS_SIZE]);
+        condition->b = RM_GetUint32(&buffer[2 + RM_ADDRESS_SIZE + 4]);
+
+        if( (condition->kind >= RM_TRIGGER_KIND_NUM) ||
+            ((condition->size != 1) && (condition->size != 2) && (condition->size != 4)) ||
+            ((condition->type != RM_TYPE_UNSIGNED) && (condition->type != RM_TYPE_SIGNED) && (condition->type != RM_TYPE_FLOAT)) ||
+            ((condition->type == RM_TYPE_FLOAT) && (condition->size != 4)) )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        if( RM_IsAccessible(pContents, condition->address, condition->size, RM_ACCESS_READ) == false )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        condition->previous = RM_ReadValue(condition->address, condition->size);
+    }
+
+    memcpy(trigger->condition, conditions, count * sizeof(RM_TriggerCondition));
+    trigger->isAnyCondition = (pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1] != 0);
+    trigger->conditionCount = (uint8_t)count;
+    trigger->sampleSize = sample_size;
+    trigger->preSamples = pre_samples;
+    trigger->postSamples = post_samples;
+    trigger->head = 0;
+    trigger->stored = 0;
+    trigger->remaining = 0;
+    trigger->state = RM_TRIGGER_STATE_ARMED;
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_ReadCapture( RM_contents* pContents )
+ * @brief Responds with the trigger state and the captured samples, starting at the requested sample.
+ * 
+ * Request payload: code, start sample(2). The response holds state(1), sample size(2), total(2),
+ * trigger index(2), start(2) and as many samples as fit, oldest first. Samples are only returned
+ * in RM_TRIGGER_STATE_DONE, the host polls until then. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_ReadCapture( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_TRIGGER
+    uint16_t start;
+
+    if( pContents->rxData.length != (1 + 3) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    start  = (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2];
+    start  = start << 8;
+    start |= (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
+
+    pContents->trigger.readIndex = start;
+    pContents->responseFunction = RM_GetCaptureData;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_SetLogMode( RM_contents* pContents )
+ * @brief Selects what log frames carry, the samples of the log table or their aggregates.
+ * 
+ * Request payload: code, mode(1). RM_LOG_MODE_AGGREGATE is followed by one record per log entry
+ * of bins << 4 | type(1), and bin lower(4) and bin width(4) as float when bins is not 0.
+ * Aggregate frames hold ticks(2), then min(size), max(size), mean(4), variance(4) as float and
+ * bins(2 each) of every entry.
+ * RM_LOG_MODE_SCHEDULE is followed by records of count(1), divisor(1), each for count consecutive
+ * log entries. Scheduled frames hold the schedule ID(1) and the entries due in that period, and
+ * periods without any entry due are not sent.
+ * RM_LOG_MODE_CHANGE is followed by one record per log entry of mask << 4 | type(1), threshold(4).
+ * An entry is sent in the tick it moves beyond the deadband threshold from the value it was last
+ * sent with, or with mask set, when a bit of threshold flips. Change frames hold a bitmap of
+ * (entries + 7) / 8 bytes, entry 0 in bit 0 of the first byte, and the flagged entries. Every
+ * period all entries are sent as a heartbeat. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_SetLogMode( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_AGGREGATION
+    RM_Aggregate* aggregate;
+    uint8_t* buffer;
+    uint16_t available_size;
+    uint16_t base_index;
+    float    bin_width;
+#endif
+#ifdef RM_SUPPORT_SCHEDULE
+    uint32_t length;
+    uint16_t count;
+    uint16_t entry_count;
+    uint8_t  gcd;
+    uint8_t  remainder;
+    uint8_t  next;
+#endif
+#ifdef RM_SUPPORT_CHANGE_LOG
+    RM_ChangeFilter* filter;
+#endif
+#if defined(RM_SUPPORT_AGGREGATION) || defined(RM_SUPPORT_SCHEDULE) || defined(RM_SUPPORT_CHANGE_LOG)
+    uint8_t* record;
+    uint16_t frame_size;
+    uint16_t index;
+    uint8_t  size;
+#endif
+
+    if( pContents->rxData.length < (1 + 2) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    switch( pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1] )
+    {
+    case RM_LOG_MODE_SAMPLE:
+        if( pContents->rxData.length != (1 + 2) )
+        {
+            return RM_STATUS_ERR;
+        }
+        break;
+
+#ifdef RM_SUPPORT_AGGREGATION
+    case RM_LOG_MODE_AGGREGATE:
+        /* Keep sending samples until the whole request is validated */
+        pContents->logMode = RM_LOG_MODE_SAMPLE;
+
+        if( (pContents->log.availableIndex == 0) ||
+            (pContents->log.availableIndex > RM_AGGREGATE_ENTRY_NUM) )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        available_size = pContents->rxData.length - 1 - 2;
+        base_index = RM_FRAME_PAYLOAD + 2;
+        frame_size = RM_AGGREGATE_HEADER_SIZE;
+
+        for( index = 0; index < pContents->log.availableIndex; index++ )
+        {
+            if( available_size < RM_AGGREGATE_RECORD_SIZE )
+            {
+                return RM_STATUS_ERR;
+            }
+
+            aggregate = &pContents->aggregate[index];
+            buffer = &pContents->rxData.buffer[base_index];
+            size = pContents->log.sizeArray[index];
+
+            aggregate->type = buffer[0] & 0x0F;
+            aggregate->binCount = buffer[0] >> 4;
+
+            if( ((size != 1) && (size != 2) && (size != 4)) ||
+                ((aggregate->type != RM_TYPE_UNSIGNED) && (aggregate->type != RM_TYPE_SIGNED) && (aggregate->type != RM_TYPE_FLOAT)) ||
+                ((aggregate->type == RM_TYPE_FLOAT) && (size != 4)) ||
+                (aggregate->binCount > RM_AGGREGATE_BIN_NUM) )
+            {
+                return RM_STATUS_ERR;
+            }
+
+            available_size -= RM_AGGREGATE_RECORD_SIZE;
+            base_index += RM_AGGREGATE_RECORD_SIZE;
+
+            if( aggregate->binCount != 0 )
+            {
+                if( available_size < RM_AGGREGATE_BIN_SIZE )
+                {
+                    return RM_STATUS_ERR;
+                }
+
+                aggregate->binLower = RM_GetFloatValue(RM_TYPE_FLOAT, 4, RM_GetUint32(&buffer[RM_AGGREGATE_RECORD_SIZE]));
+                bin_width = RM_GetFloatValue(RM_TYPE_FLOAT, 4, RM_GetUint32(&buffer[RM_AGGREGATE_RECORD_SIZE + 4]));
+                if( !(bin_width > 0.0f) )
+                {
+                    return RM_STATUS_ERR;
+                }
+                aggregate->binScale = 1.0f / bin_width;
+
+                available_size -= RM_AGGREGATE_BIN_SIZE;
+                base_index += RM_AGGREGATE_BIN_SIZE;
+            }
+
+            frame_size += (uint16_t)(size + size + RM_AGGREGATE_ENTRY_SIZE + aggregate->binCount * 2);
+        }
+
+        if( (available_size != 0) || (frame_size > RM_SND_PAYLOAD_SIZE) )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        /* The first aggregate covers a whole period */
+        pContents->aggregateCount = 0;
+        pContents->logIntervalCnt = 0;
+        break;
+#endif
+
+#ifdef RM_SUPPORT_SCHEDULE
+    case RM_LOG_MODE_SCHEDULE:
+        pContents->logMode = RM_LOG_MODE_SAMPLE;
+
+        if( ((pContents->rxData.length - 1 - 2) % RM_SCHEDULE_RECORD_SIZE) != 0 )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        count = (pContents->rxData.length - 1 - 2) / RM_SCHEDULE_RECORD_SIZE;
+        entry_count = 0;
+        length = 1;
+
+        for( index = 0; index < count; index++ )
+        {
+            record = &pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2 + index * RM_SCHEDULE_RECORD_SIZE];
+
+            entry_count += record[0];
+            if( (record[1] == 0) || (entry_count > pContents->log.availableIndex) )
+            {
+                return RM_STATUS_ERR;
+            }
+
+            /* length = lcm(length, divisor) */
+            gcd = record[1];
+            remainder = (uint8_t)(length % record[1]);
+            while( remainder != 0 )
+            {
+                next = gcd % remainder;
+                gcd = remainder;
+                remainder = next;
+            }
+
+            length = length / gcd * record[1];
+            if( length > RM_SCHEDULE_LENGTH_MAX )
+            {
+                return RM_STATUS_ERR;
+            }
+        }
+
+        if( (entry_count == 0) || (entry_count != pContents->log.availableIndex) )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        frame_size = RM_SCHEDULE_HEADER_SIZE;
+        for( index = 0; index < pContents->log.availableIndex; index++ )
+        {
+            frame_size += pContents->log.sizeArray[index];
+        }
+
+        if( frame_size > RM_SND_PAYLOAD_SIZE )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        entry_count = 0;
+        for( index = 0; index < count; index++ )
+        {
+            record = &pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2 + index * RM_SCHEDULE_RECORD_SIZE];
+            memset(&pContents->logDivisor[entry_count], record[1], record[0]);
+            entry_count += record[0];
+        }
+
+        /* Schedule ID 0 sends every entry */
+        pContents->logScheduleLength = (uint16_t)length;
+        pContents->logScheduleId = 0;
+        pContents->logIntervalCnt = 0;
+        break;
+#endif
+
+#ifdef RM_SUPPORT_CHANGE_LOG
+    case RM_LOG_MODE_CHANGE:
+        pContents->logMode = RM_LOG_MODE_SAMPLE;
+
+        if( (pContents->log.availableIndex == 0) ||
+            (pContents->log.availableIndex > RM_CHANGE_ENTRY_NUM) ||
+            (pContents->rxData.length != (1 + 2 + pContents->log.availableIndex * RM_CHANGE_RECORD_SIZE)) )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        frame_size = (pContents->log.availableIndex + 7) / 8;
+        for( index = 0; index < pContents->log.availableIndex; index++ )
+        {
+            filter = &pContents->changeFilter[index];
+            record = &pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2 + index * RM_CHANGE_RECORD_SIZE];
+            size = pContents->log.sizeArray[index];
+
+            filter->type = record[0] & 0x0F;
+            filter->isMask = ((record[0] >> 4) != 0);
+            filter->threshold = RM_GetUint32(&record[1]);
+
+            if( ((size != 1) && (size != 2) && (size != 4)) ||
+                ((filter->type != RM_TYPE_UNSIGNED) && (filter->type != RM_TYPE_SIGNED) && (filter->type != RM_TYPE_FLOAT)) ||
+                ((filter->type == RM_TYPE_FLOAT) && (size != 4)) )
+            {
+                return RM_STATUS_ERR;
+            }
+
+            frame_size += size;
+        }
+
+        if( frame_size > RM_SND_PAYLOAD_SIZE )
+        {
+            return RM_STATUS_ERR;
+        }
+
+        /* The first tick sends a heartbeat, which sets the values to compare with */
+        pContents->logIntervalCnt = pContents->logIntervalPeriod;
+        break;
+#endif
+
+    default:
+        return RM_STATUS_ERR;
+    }
+
+    pContents->logMode = pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+
+    return RM_STATUS_SUCCESS;
+}
+
+/** 
+ * @fn RM_Status RM_HashRegion( RM_contents* pContents )
+ * @brief Starts the CRC-32 of a memory range, computed RM_HASH_SLICE_SIZE bytes per RM_Task().
+ * 
+ * Request payload: code, address, length, chunk size, all of RM_ADDRESS_SIZE bytes. With a chunk
+ * size, the digest of every chunk is kept as well, at most RM_HASH_CHUNK_NUM of them. A running
+ * hash is restarted. The digests are read with RM_EXTCODE_READ_HASH. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_HashRegion( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_HASH
+    RM_Hash* hash;
+    rm_address_t address;
+    rm_address_t length;
+    rm_address_t chunk_size;
+
+    if( pContents->rxData.length != (1 + 1 + RM_ADDRESS_SIZE * 3) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    hash = &pContents->hash;
+    address = RM_GetAddress(&pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1]);
+    length = RM_GetAddress(&pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1 + RM_ADDRESS_SIZE]);
+    chunk_size = RM_GetAddress(&pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1 + RM_ADDRESS_SIZE * 2]);
+
+    if( (length == 0) ||
+        ((chunk_size != 0) && (((length - 1) / chunk_size) >= RM_HASH_CHUNK_NUM)) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    if( RM_IsAccessible(pContents, address, length, RM_ACCESS_READ) == false )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    hash->address = address;
+    hash->length = length;
+    hash->remaining = length;
+    hash->chunkSize = chunk_size;
+    hash->chunkRemaining = chunk_size;
+    hash->crc = 0xFFFFFFFFUL;
+    hash->chunkCrc = 0xFFFFFFFFUL;
+    hash->chunkCount = 0;
+    hash->state = RM_HASH_STATE_RUNNING;
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_ReadHash( RM_contents* pContents )
+ * @brief Responds with the state and the digests of the region hash.
+ * 
+ * Request payload: code. The response holds state(1), hashed bytes(RM_ADDRESS_SIZE), digest(4),
+ * chunk count(1) and the digest(4) of each completed chunk. The digest is only final in
+ * RM_HASH_STATE_DONE, the host polls until then. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_ReadHash( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_HASH
+    if( pContents->rxData.length != (1 + 1) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    pContents->responseFunction = RM_GetHashData;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_TakeSnapshot( RM_contents* pContents )
+ * @brief Takes the baseline of a memory range for RM_EXTCODE_READ_DIFF.
+ * 
+ * Request payload: code, address, length(2), block size(2). With a block size of 0 the range is
+ * copied and must fit RM_SNAPSHOT_BUFFER_SIZE. Otherwise the CRC-32 of each block is kept, a block
+ * holds at most RM_DIFF_BLOCK_SIZE_MAX bytes. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_TakeSnapshot( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_SNAPSHOT
+    RM_Snapshot* snapshot;
+    uint8_t* data;
+    rm_address_t address;
+    uint16_t length;
+    uint16_t block_size;
+    uint16_t offset;
+    uint16_t size;
+    uint16_t index;
+
+    if( pContents->rxData.length != (1 + 1 + RM_ADDRESS_SIZE + 2 + 2) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    snapshot = &pContents->snapshot;
+    address = RM_GetAddress(&pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1]);
+    length  = (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1 + RM_ADDRESS_SIZE + 1] << 8;
+    length |= (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1 + RM_ADDRESS_SIZE];
+    block_size  = (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1 + RM_ADDRESS_SIZE + 3] << 8;
+    block_size |= (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1 + RM_ADDRESS_SIZE + 2];
+
+    snapshot->length = 0;
+
+    if( (length == 0) ||
+        ((block_size == 0) && (length > RM_SNAPSHOT_BUFFER_SIZE)) ||
+        ((block_size != 0) && ((block_size > RM_DIFF_BLOCK_SIZE_MAX) ||
+                               ((uint16_t)((length - 1) / block_size) >= (RM_SNAPSHOT_BUFFER_SIZE / 4)))) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    if( RM_IsAccessible(pContents, address, length, RM_ACCESS_READ) == false )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    data = (uint8_t*)(uintptr_t)address;
+
+    if( block_size == 0 )
+    {
+        memcpy(snapshot->buffer, data, length);
+    }
+    else
+    {
+        index = 0;
+        for( offset = 0; offset < length; offset += size )
+        {
+            size = ((length - offset) < block_size) ? (length - offset) : block_size;
+            RM_SetUint32(&snapshot->buffer[index], ~RM_UpdateCRC32(0xFFFFFFFFUL, &data[offset], size));
+            index += 4;
+        }
+    }
+
+    snapshot->address = address;
+    snapshot->length = length;
+    snapshot->blockSize = block_size;
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_ReadDiff( RM_contents* pContents )
+ * @brief Responds with the bytes of the snapshot range that changed since they were last sent.
+ * 
+ * Request payload: code, start offset(2). The response holds the offset(2) to request next, equal
+ * to the length once the range is scanned, and runs of offset(2), count(1) and count bytes. A
+ * response scans at most RM_HASH_SLICE_SIZE bytes, so it may hold no run before the end. The sent
+ * bytes become the baseline. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_ReadDiff( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_SNAPSHOT
+    uint16_t start;
+
+    if( (pContents->rxData.length != (1 + 3)) || (pContents->snapshot.length == 0) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    start  = (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 2];
+    start  = start << 8;
+    start |= (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
+
+    /* Blocks are compared whole */
+    if( (start > pContents->snapshot.length) ||
+        ((pContents->snapshot.blockSize != 0) && ((start % pContents->snapshot.blockSize) != 0)) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    pContents->snapshot.readOffset = start;
+    pContents->responseFunction = RM_GetDiffData;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_SetCompressedDump( RM_contents* pContents )
+ * @brief Dumps a memory range compressed with run-length encoding.
+ * 
+ * Request payload: code, address, length(2). The response holds the number of bytes consumed(2),
+ * then as many tokens as fit: 0x00-0x7F is followed by control + 1 literal bytes, 0x80-0xFE by a
+ * byte repeated control - 0x80 + 3 times, and 0xFF by count(2) and a byte repeated count times.
+ * A response covers at most RM_COMPRESS_SCAN_SIZE bytes, so its duration stays bounded. The host
+ * requests the rest from address + consumed. This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_SetCompressedDump( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_COMPRESSION
+    rm_address_t address;
+    uint16_t length;
+
+    if( pContents->rxData.length != (1 + 1 + RM_ADDRESS_SIZE + 2) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    address = RM_GetAddress(&pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1]);
+    length  = (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1 + RM_ADDRESS_SIZE + 1] << 8;
+    length |= (uint16_t)pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1 + RM_ADDRESS_SIZE];
+
+    if( RM_IsAccessible(pContents, address, length, RM_ACCESS_READ) == false )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    /* RM_GetCompressedData() reads the range from block */
+    pContents->block.address = address;
+    pContents->block.length = length;
+    pContents->responseFunction = RM_GetCompressedData;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/** 
+ * @fn RM_Status RM_SetFraming( RM_contents* pContents )
+ * @brief Switches the framing of both directions.
+ * 
+ * Request: code, framing(1) as RM_Framing. The response is already sent in the new framing, and a target
+ * without RM_SUPPORT_COBS does not respond, so the host keeps RM_FRAMING_SLIP when no response comes.
+ * After RM_REQ_TIMEOUT_CNT without a valid frame the framing returns to RM_FRAMING_DEFAULT.
+ * This request does not stop logging.
+ * 
+ * @param pContents Pointer to RM_contents structure containing relevant data and configurations.
+ * @return RM_Status indicating the success or failure of the operation.
+ */
+RM_Status RM_SetFraming( RM_contents* pContents )
+{
+#ifdef RM_SUPPORT_COBS
+    uint8_t framing;
+
+    if( pContents->rxData.length != (1 + 1 + 1) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    framing = pContents->rxData.buffer[RM_FRAME_PAYLOAD + 1];
+    if( (framing != RM_FRAMING_SLIP) && (framing != RM_FRAMING_COBS) )
+    {
+        return RM_STATUS_ERR;
+    }
+
+    /* The received frame is complete, the next one is decoded with the new framing */
+    pContents->rxData.framing = framing;
+    pContents->framingTimeoutCnt = 0;
+
+    pContents->block.address = 0;
+    pContents->block.length = 0;
+
+    return RM_STATUS_SUCCESS;
+#else
+    (void)pContents;
+    return RM_STATUS_ERR;
+#endif
+}
+
+/**
+ * @fn uint16_t RM_GetLogData( RM_LogInformation* pLogInformation, RM_TransmittingData* pTransmitData )
+ * @brief Retrieves log data for transmission.
+ * 
+ * @param pLogInformation Pointer to RM_LogInformation structure.
+ * @param pTransmitData Pointer to RM_TransmittingData structure.
+ * @return The size of the log data prepared for transmission.
+ */
+uint16_t RM_GetLogData( RM_LogInformation* pLogInformation, RM_TransmittingData* pTransmitData )
+{
+    uint16_t data_size;
+
+    if(pLogInformation->availableIndex == 0)
+    {
+        return 0;
+    }
+
+    data_size = RM_GatherLogData( pLogInformation, &pTransmitData->buffer[RM_FRAME_PAYLOAD] );
+
+    /* The returned size counts RM_FRAME_PAYLOAD as well, RM Classic expects log frames of this length */
+    return RM_FRAME_PAYLOAD + data_size;
+}
+
+/**
+ * @fn uint16_t RM_GatherLogData( RM_LogInformation* pLogInformation, uint8_t buffer[] )
+ * @brief Copies the current values of the log table into buffer, in little-endian order.
+ * 
+ * @param pLogInformation Pointer to RM_LogInformation structure.
+ * @param buffer[] Array of at least RM_SND_PAYLOAD_SIZE bytes.
+ * @return The number of bytes written.
+ */
+uint16_t RM_GatherLogData( RM_LogInformation* pLogInformation, uint8_t buffer[] )
+{
+    uint16_t index;
+    uint16_t payload_index;
+    RM_PROFILE_BEGIN(profile_start);
+
+    payload_index = 0;
+    for( index = 0; index < pLogInformation->availableIndex; index++ )
+    {
+        payload_index += RM_GatherLogEntry( pLogInformation->addressArray[index], pLogInformation->sizeArray[index], &buffer[payload_index] );
+    }
+
+    RM_PROFILE_END(RM_PROFILE_STAGE_GETLOG, profile_start);
+    return payload_index;
+}
+
+/**
+ * @fn uint8_t RM_GatherLogEntry( rm_address_t address, uint8_t size, uint8_t buffer[] )
+ * @brief Copies the current value of one log entry into buffer, in little-endian order.
+ * 
+ * @param address Address of the entry.
+ * @param size Size of the entry, 1, 2, 4 or 8.
+ * @param buffer[] Array of at least size bytes.
+ * @return The number of bytes written.
+ */
+uint8_t RM_GatherLogEntry( rm_address_t address, uint8_t size, uint8_t buffer[] )
+{
+    uint8_t  payload_index;
+
+    uint8_t  data_8bit;
+    uint8_t* ptr_8bit;
+
+    uint16_t  data_16bit;
+    uint16_t* ptr_16bit;
+
+    uint32_t  data_32bit;
+    uint32_t* ptr_32bit;
+
+#ifdef RM_SUPPORT_64BIT
+    uint64_t  data_64bit;
+    uint64_t* ptr_64bit;
+#endif
+
+    payload_index = 0;
+
+    switch( size )
+    {
+    case 1:
+        ptr_8bit = (uint8_t*)(uintptr_t)address;
+        data_8bit = *ptr_8bit;
+
+        buffer[payload_index] = data_8bit;
+        payload_index++;
+
+        break;
+
+    case 2:
+        ptr_16bit = (uint16_t*)(uintptr_t)address;
+        data_16bit = *ptr_16bit;
+
+        buffer[payload_index] = (uint8_t)(data_16bit);
+        payload_index++;
+        data_16bit = data_16bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_16bit);
+        payload_index++;
+
+        break;
+
+    case 4:
+        ptr_32bit = (uint32_t*)(uintptr_t)address;
+        data_32bit = *ptr_32bit;
+
+        buffer[payload_index] = (uint8_t)(data_32bit);
+        payload_index++;
+        data_32bit = data_32bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_32bit);
+        payload_index++;
+        data_32bit = data_32bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_32bit);
+        payload_index++;
+        data_32bit = data_32bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_32bit);
+        payload_index++;
+
+        break;
+
+#ifdef RM_SUPPORT_64BIT
+    case 8:
+        ptr_64bit = (uint64_t*)(uintptr_t)address;
+        data_64bit = *ptr_64bit;
+
+        buffer[payload_index] = (uint8_t)(data_64bit);
+        payload_index++;
+        data_64bit = data_64bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_64bit);
+        payload_index++;
+        data_64bit = data_64bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_64bit);
+        payload_index++;
+        data_64bit = data_64bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_64bit);
+        payload_index++;
+        data_64bit = data_64bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_64bit);
+        payload_index++;
+        data_64bit = data_64bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_64bit);
+        payload_index++;
+        data_64bit = data_64bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_64bit);
+        payload_index++;
+        data_64bit = data_64bit >> 8;
+        buffer[payload_index] = (uint8_t)(data_64bit);
+        payload_index++;
+
+        break;
+
+#endif
+    default:
+        break;
+
+    }
+
+    return payload_index;
+}
+
+/** 
+ * @fn uint16_t RM_GetBlockData( RM_Data* pData, RM_TransmittingData* pTransmitData )
+ * @brief Retrieves block data for transmission.
+ * 
+ * @param pData Pointer to RM_Data structure.
+ * @param pTransmitData Pointer to RM_TransmittingData structure.
+ * @return The size of the block data prepared for transmission.
+ */
+uint16_t RM_GetBlockData( RM_Data* pData, RM_TransmittingData* pTransmitData )
+{
+    uint16_t index;
+    uint8_t* ptr_data;
+
+    ptr_data = (uint8_t*)(uintptr_t)pData->address;
+    for( index = 0; index < pData->length; index++ )
+    {
+        pTransmitData->buffer[RM_FRAME_PAYLOAD + index] = *ptr_data;
+        ptr_data++;
+    }
+
+    return index;
+}
+
+#ifdef RM_SUPPORT_REGISTRY
+/** 
+ * @fn void RM_AttachRegistry( RM_contents* obj, const RM_RegistryEntry table[], uint16_t count )
+ * @brief Publishes a variable table to the host.
+ * 
+ * @param obj Pointer to RM_contents structure.
+ * @param table[] Array of entries declared with RM_REGISTRY_ENTRY() in RM_FLASH.
+ * @param count Number of entries.
+ */
+void RM_AttachRegistry( RM_contents* obj, const RM_RegistryEntry table[], uint16_t count )
+{
+    obj->registry = table;
+    obj->registryCount = count;
+}
+#endif
+
+#ifdef RM_SUPPORT_ACCESS_CHECK
+/** 
+ * @fn bool RM_AttachAccessRegions( RM_contents* obj, const RM_AccessRegion table[], uint16_t count )
+ * @brief Restricts host reads and writes to a table of regions.
+ * 
+ * The log table and the uploaded log profiles are cleared, since their entries were not checked.
+ * 
+ * @param obj Pointer to RM_contents structure.
+ * @param table[] Array of regions sorted by start, in RM_FLASH. NULL removes the restriction.
+ * @param count Number of regions.
+ * @return true if the table is attached, false if it is not sorted, regions overlap or a region wraps.
+ */
+bool RM_AttachAccessRegions( RM_contents* obj, const RM_AccessRegion table[], uint16_t count )
+{
+    RM_AccessRegion region;
+    rm_address_t start;
+    rm_address_t end;
+    uint16_t index;
+
+    end = 0;
+    for( index = 0; index < count; index++ )
+    {
+        RM_FLASH_READ(&region, &table[index], sizeof(region));
+        start = (rm_address_t)(uintptr_t)region.start;
+
+        /* start + size must not wrap, or the region would pass the order check */
+        if( (region.size > (rm_address_t)(RM_ADDRESS_MAX - start)) ||
+            ((index > 0) && (start < end)) )
+        {
+            return false;
+        }
+        end = (rm_address_t)(start + region.size);
+    }
+
+    obj->accessRegion = table;
+    obj->accessRegionCount = (table != (const RM_AccessRegion*)0) ? count : 0;
+
+    obj->isLogging = false;
+    obj->logMode = RM_LOG_MODE_SAMPLE;
+    obj->log.currentIndex = 0;
+    obj->log.availableIndex = 0;
+#ifdef RM_SUPPORT_LOG_PROFILE
+    memset(obj->logProfileSlot, 0, sizeof(obj->logProfileSlot));
+#endif
+
+    return true;
+}
+#endif
+
+#ifdef RM_SUPPORT_SESSION
+/** 
+ * @fn void RM_AttachStorage( RM_contents* obj, rm_storage_function_t saveFunc, rm_storage_function_t loadFunc )
+ * @brief Attaches the hooks that keep a RM_SessionRecord across resets.
+ * 
+ * Both hooks get a buffer and its size and return false on failure. They are called from RM_Task(),
+ * a slow EEPROM or flash write delays RM framing for its duration.
+ * 
+ * @param obj Pointer to RM_contents structure.
+ * @param saveFunc Writes the buffer to storage.
+ * @param loadFunc Fills the buffer from storage.
+ */
+void RM_AttachStorage( RM_contents* obj, rm_storage_function_t saveFunc, rm_storage_function_t loadFunc )
+{
+    obj->saveFunction = saveFunc;
+    obj->loadFunction = loadFunc;
+}
+
+/** 
+ * @fn void RM_AttachBuildId( RM_contents* obj, const uint8_t id[], uint16_t size )
+ * @brief Attaches an identifier of the firmware image, such as a linker build ID or a source hash.
+ * 
+ * A saved RM_SessionRecord is only resumed by the image with the same identifier. Without it the
+ * record is keyed on the version information alone. The array must stay valid.
+ * 
+ * @param obj Pointer to RM_contents structure.
+ * @param id[] Array containing the identifier.
+ * @param size Size of the id array.
+ */
+void RM_AttachBuildId( RM_contents* obj, const uint8_t id[], uint16_t size )
+{
+    obj->buildId = id;
+    obj->buildIdSize = size;
+}
+#endif
+
+#ifdef RM_SUPPORT_LOG_PROFILE
+/** 
+ * @fn void RM_AttachLogProfiles( RM_contents* obj, const RM_LogProfile table[], uint16_t count )
+ * @brief Attaches log profiles compiled into the firmware.
+ * 
+ * @param obj Pointer to RM_contents structure.
+ * @param table[] Array of profiles declared with RM_LOG_PROFILE() in RM_FLASH.
+ * @param count Number of profiles, together with RM_LOG_PROFILE_SLOT_NUM at most 255.
+ */
+void RM_AttachLogProfiles( RM_contents* obj, const RM_LogProfile table[], uint16_t count )
+{
+    obj->logProfile = table;
+    obj->logProfileCount = count;
+}
+
+/** 
+ * @fn bool RM_SelectLogProfile( RM_contents* obj, uint8_t index )
+ * @brief Replaces the active log table and period with a log profile.
+ * 
+ * The whole profile is checked before anything is replaced. Logging keeps running and
+ * RM_contents::logIntervalCnt is not reset, so the log stream has no gap at the switch.
+ * 
+ * @param obj Pointer to RM_contents structure.
+ * @param index Compiled-in profiles first, then the slots uploaded by the host.
+ * @return true if the profile is active, false if it does not exist or is empty or invalid.
+ */
+bool RM_SelectLogProfile( RM_contents* obj, uint8_t index )
+{
+    RM_LogProfile profile;
+    RM_LogProfileEntry entry;
+    RM_LogProfileSlot* slot;
+    uint16_t total_size;
+    uint16_t entry_index;
+
+    if( index >= obj->logProfileCount )
+    {
+        if( (index - obj->logProfileCount) >= RM_LOG_PROFILE_SLOT_NUM )
+        {
+            return false;
+        }
+
+        slot = &obj->logProfileSlot[index - obj->logProfileCount];
+        if( slot->log.availableIndex == 0 )
+        {
+            return false;
+        }
+
+        obj->log = slot->log;
+        obj->logIntervalPeriod = slot->logIntervalPeriod;
+        obj->logMode = RM_LOG_MODE_SAMPLE;
+        return true;
+    }
+
+    RM_FLASH_READ(&profile, &obj->logProfile[index], sizeof(profile));
+    if( (profile.count == 0) ||
+        (profile.count > RM_LOG_FACTOR_MAX) ||
+        (profile.logIntervalPeriod == 0) )
+    {
+        return false;
+    }
+
+    total_size = 0;
+    for( entry_index = 0; entry_index < profile.count; entry_index++ )
+    {
+        RM_FLASH_READ(&entry, &profile.entries[entry_index], sizeof(entry));
+        total_size += entry.size;
+
+#ifdef RM_SUPPORT_64BIT
+        if( (entry.size != 1) && (entry.size != 2) && (entry.size != 4) && (entry.size != 8) )
+#else
+        if( (entry.size != 1) && (entry.size != 2) && (entry.size != 4) )
+#endif
+        {
+            return false;
+        }
+    }
+
+    if( total_size > RM_SND_PAYLOAD_SIZE )
+    {
+        return false;
+    }
+
+    for( entry_index = 0; entry_index < profile.count; entry_index++ )
+    {
+        RM_FLASH_READ(&entry, &profile.entries[entry_index], sizeof(entry));
+        obj->log.sizeArray[entry_index] = entry.size;
+        obj->log.addressArray[entry_index] = (rm_address_t)(uintptr_t)entry.address;
+    }
+
+    obj->log.currentIndex = profile.count;
+    obj->log.availableIndex = profile.count;
+    obj->logIntervalPeriod = profile.logIntervalPeriod;
+    obj->logMode = RM_LOG_MODE_SAMPLE;
+
+    return true;
+}
+#endif
+
+/** 
+ * @fn bool RM_IsAccessible( RM_contents* obj, rm_address_t address, rm_address_t length, uint8_t access )
+ * @brief Checks that a host supplied range lies in one attached region with the requested access.
+ * 
+ * The regions are found by a binary search. Without an attached table any range is accessible.
+ * 
+ * @param obj Pointer to RM_contents structure.
+ * @param address First address of the range.
+ * @param length Size of the range.
+ * @param access RM_ACCESS_READ or RM_ACCESS_WRITE.
+ * @return true if the range is accessible, false otherwise.
+ */
+bool RM_IsAccessible( RM_contents* obj, rm_address_t address, rm_address_t length, uint8_t access )
+{
+#ifdef RM_SUPPORT_ACCESS_CHECK
+    RM_AccessRegion region;
+    rm_address_t start;
+    rm_address_t offset;
+    uint16_t low;
+    uint16_t high;
+    uint16_t middle;
+
+    if( obj->accessRegionCount == 0 )
+    {
+        return true;
+    }
+
+    /* Find the last region starting at or below address */
+    low = 0;
+    high = obj->accessRegionCount;
+    while( (high - low) > 1 )
+    {
+        middle = low + ((high - low) >> 1);
+        RM_FLASH_READ(&region, &obj->accessRegion[middle], sizeof(region));
+        if( (rm_address_t)(uintptr_t)region.start <= address )
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    RM_FLASH_READ(&region, &obj->accessRegion[low], sizeof(region));
+    start = (rm_address_t)(uintptr_t)region.start;
+    offset = (rm_address_t)(address - start);
+
+    if( (address >= start) &&
+        (offset < region.size) &&
+        (length <= (rm_address_t)(region.size - offset)) &&
+        ((region.access & access) == access) )
+    {
+        return true;
+    }
+
+    RM_STATISTICS_COUNT(obj->statistics.accessDenied);
+    return false;
+#else
+    (void)obj;
+    (void)address;
+    (void)length;
+    (void)access;
+    return true;
+#endif
+}
+
+/** 
+ * @fn uint16_t RM_GetRegistryData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Serializes registry entries from RM_contents::registryIndex into the response payload.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes.
+ * @return The size of the payload.
+ */
+uint16_t RM_GetRegistryData( RM_contents* pContents, uint8_t payload[] )
+{
+#ifdef RM_SUPPORT_REGISTRY
+    RM_RegistryEntry entry;
+    uint16_t index;
+    uint16_t payload_index;
+    uint8_t  name_length;
+    uint8_t  count;
+
+    payload_index = RM_REGISTRY_HEADER_SIZE;
+    count = 0;
+
+    for( index = pContents->registryIndex; index < pContents->registryCount; index++ )
+    {
+        RM_FLASH_READ(&entry, &pContents->registry[index], sizeof(entry));
+
+        name_length = 0;
+        while( (name_length < RM_REGISTRY_NAME_SIZE) && (entry.name[name_length] != '\0') )
+        {
+            name_length++;
+        }
+
+        if( (payload_index + RM_REGISTRY_RECORD_SIZE + name_length) > RM_SND_PAYLOAD_SIZE )
+        {
+            break;
+        }
+
+        payload[payload_index++] = entry.type;
+        payload[payload_index++] = (uint8_t)(entry.size);
+        payload[payload_index++] = (uint8_t)(entry.size >> 8);
+        RM_SetAddress(&payload[payload_index], (rm_address_t)(uintptr_t)entry.address);
+        payload_index += RM_ADDRESS_SIZE;
+        payload[payload_index++] = name_length;
+        memcpy(&payload[payload_index], entry.name, name_length);
+        payload_index += name_length;
+
+        count++;
+    }
+
+    payload[0] = (uint8_t)(pContents->registryCount);
+    payload[1] = (uint8_t)(pContents->registryCount >> 8);
+    payload[2] = (uint8_t)(pContents->registryIndex);
+    payload[3] = (uint8_t)(pContents->registryIndex >> 8);
+    payload[4] = count;
+
+    return payload_index;
+#else
+    (void)pContents;
+    (void)payload;
+    return 0;
+#endif
+}
+
+/** 
+ * @fn uint16_t RM_GetLogProfileData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Serializes log profiles from RM_contents::logProfileIndex into the response payload.
+ * 
+ * Each record is period(2), entries(1), name length(1) and the name. Empty slots have 0 entries.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes.
+ * @return The size of the payload.
+ */
+uint16_t RM_GetLogProfileData( RM_contents* pContents, uint8_t payload[] )
+{
+#ifdef RM_SUPPORT_LOG_PROFILE
+    RM_LogProfile profile;
+    uint16_t total;
+    uint16_t index;
+    uint16_t payload_index;
+    uint8_t  name_length;
+    uint8_t  count;
+
+    total = pContents->logProfileCount + RM_LOG_PROFILE_SLOT_NUM;
+    payload_index = RM_PROFILE_LIST_HEADER_SIZE;
+    count = 0;
+
+    for( index = pContents->logProfileIndex; index < total; index++ )
+    {
+        if( index < pContents->logProfileCount )
+        {
+            RM_FLASH_READ(&profile, &pContents->logProfile[index], sizeof(profile));
+        }
+        else
+        {
+            memcpy(profile.name, pContents->logProfileSlot[index - pContents->logProfileCount].name, sizeof(profile.name));
+            profile.logIntervalPeriod = pContents->logProfileSlot[index - pContents->logProfileCount].logIntervalPeriod;
+            profile.count = pContents->logProfileSlot[index - pContents->logProfileCount].log.availableIndex;
+        }
+
+        name_length = 0;
+        while( (name_length < RM_LOG_PROFILE_NAME_SIZE) && (profile.name[name_length] != '\0') )
+        {
+            name_length++;
+        }
+
+        if( (payload_index + RM_PROFILE_LIST_RECORD_SIZE + name_length) > RM_SND_PAYLOAD_SIZE )
+        {
+            break;
+        }
+
+        payload[payload_index++] = (uint8_t)(profile.logIntervalPeriod);
+        payload[payload_index++] = (uint8_t)(profile.logIntervalPeriod >> 8);
+        payload[payload_index++] = (uint8_t)(profile.count);
+        payload[payload_index++] = name_length;
+        memcpy(&payload[payload_index], profile.name, name_length);
+        payload_index += name_length;
+
+        count++;
+    }
+
+    payload[0] = (uint8_t)total;
+    payload[1] = pContents->logProfileIndex;
+    payload[2] = count;
+
+    return payload_index;
+#else
+    (void)pContents;
+    (void)payload;
+    return 0;
+#endif
+}
+
+/** 
+ * @fn uint16_t RM_GetCaptureData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Serializes captured samples from RM_Trigger::readIndex into the response payload.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes.
+ * @return The size of the payload.
+ */
+uint16_t RM_GetCaptureData( RM_contents* pContents, uint8_t payload[] )
+{
+#ifdef RM_SUPPORT_TRIGGER
+    RM_Trigger* trigger;
+    uint16_t slot_count;
+    uint16_t total;
+    uint16_t slot;
+    uint16_t index;
+    uint16_t payload_index;
+
+    trigger = &pContents->trigger;
+    slot_count = trigger->preSamples + trigger->postSamples;
+    total = 0;
+    if( trigger->state == RM_TRIGGER_STATE_DONE )
+    {
+        total = trigger->stored + trigger->postSamples;
+    }
+
+    payload[0] = trigger->state;
+    payload[1] = (uint8_t)(trigger->sampleSize);
+    payload[2] = (uint8_t)(trigger->sampleSize >> 8);
+    payload[3] = (uint8_t)(total);
+    payload[4] = (uint8_t)(total >> 8);
+    payload[5] = (uint8_t)(trigger->stored);
+    payload[6] = (uint8_t)(trigger->stored >> 8);
+    payload[7] = (uint8_t)(trigger->readIndex);
+    payload[8] = (uint8_t)(trigger->readIndex >> 8);
+    payload_index = RM_CAPTURE_HEADER_SIZE;
+
+    /* The oldest sample is total slots behind the head */
+    for( index = trigger->readIndex; index < total; index++ )
+    {
+        if( (payload_index + trigger->sampleSize) > RM_SND_PAYLOAD_SIZE )
+        {
+            break;
+        }
+
+        slot = trigger->head + slot_count - total + index;
+        if( slot >= slot_count )
+        {
+            slot -= slot_count;
+        }
+
+        memcpy(&payload[payload_index], &trigger->buffer[slot * trigger->sampleSize], trigger->sampleSize);
+        payload_index += trigger->sampleSize;
+    }
+
+    return payload_index;
+#else
+    (void)pContents;
+    (void)payload;
+    return 0;
+#endif
+}
+
+#ifdef RM_SUPPORT_TRIGGER
+/** 
+ * @fn void RM_RunTrigger( RM_contents* pContents )
+ * @brief Samples the log table into the trigger ring and evaluates the conditions, once per RM_Task().
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ */
+void RM_RunTrigger( RM_contents* pContents )
+{
+    RM_Trigger* trigger;
+    uint16_t sample_size;
+    uint16_t index;
+
+    trigger = &pContents->trigger;
+    if( (trigger->state != RM_TRIGGER_STATE_ARMED) && (trigger->state != RM_TRIGGER_STATE_TRIGGERED) )
+    {
+        return;
+    }
+
+    /* A different log table would not fit the slots */
+    sample_size = 0;
+    for( index = 0; index < pContents->log.availableIndex; index++ )
+    {
+        sample_size += pContents->log.sizeArray[index];
+    }
+
+    if( sample_size != trigger->sampleSize )
+    {
+        trigger->state = RM_TRIGGER_STATE_ABORTED;
+        return;
+    }
+
+    RM_GatherLogData( &pContents->log, &trigger->buffer[trigger->head * trigger->sampleSize] );
+    trigger->head++;
+    if( trigger->head >= (trigger->preSamples + trigger->postSamples) )
+    {
+        trigger->head = 0;
+    }
+
+    if( trigger->state == RM_TRIGGER_STATE_ARMED )
+    {
+        if( RM_EvaluateTrigger(trigger) == false )
+        {
+            if( trigger->stored < trigger->preSamples )
+            {
+                trigger->stored++;
+            }
+            return;
+        }
+
+        trigger->remaining = trigger->postSamples;
+        trigger->state = RM_TRIGGER_STATE_TRIGGERED;
+    }
+
+    trigger->remaining--;
+    if( trigger->remaining == 0 )
+    {
+        trigger->state = RM_TRIGGER_STATE_DONE;
+    }
+}
+
+/** 
+ * @fn bool RM_EvaluateTrigger( RM_Trigger* pTrigger )
+ * @brief Evaluates all conditions and keeps their values for the next tick.
+ * 
+ * @param pTrigger Pointer to RM_Trigger structure.
+ * @return true if the combined conditions are met.
+ */
+bool RM_EvaluateTrigger( RM_Trigger* pTrigger )
+{
+    RM_TriggerCondition* condition;
+    uint32_t value;
+    uint8_t  index;
+    bool is_matched;
+    bool result;
+
+    result = (pTrigger->isAnyCondition == false);
+
+    for( index = 0; index < pTrigger->conditionCount; index++ )
+    {
+        condition = &pTrigger->condition[index];
+        value = RM_ReadValue(condition->address, condition->size);
+
+        switch( condition->kind )
+        {
+        case RM_TRIGGER_ABOVE:
+            is_matched = (RM_CompareValue(condition->type, condition->size, value, condition->a) > 0);
+            break;
+
+        case RM_TRIGGER_BELOW:
+            is_matched = (RM_CompareValue(condition->type, condition->size, value, condition->a) < 0);
+            break;
+
+        case RM_TRIGGER_RISING:
+            is_matched = (RM_CompareValue(condition->type, condition->size, condition->previous, condition->a) <= 0) &&
+                         (RM_CompareValue(condition->type, condition->size, value, condition->a) > 0);
+            break;
+
+        case RM_TRIGGER_FALLING:
+            is_matched = (RM_CompareValue(condition->type, condition->size, condition->previous, condition->a) >= 0) &&
+                         (RM_CompareValue(condition->type, condition->size, value, condition->a) < 0);
+            break;
+
+        case RM_TRIGGER_INSIDE:
+            is_matched = (RM_CompareValue(condition->type, condition->size, value, condition->a) >= 0) &&
+                         (RM_CompareValue(condition->type, condition->size, value, condition->b) <= 0);
+            break;
+
+        case RM_TRIGGER_OUTSIDE:
+            is_matched = (RM_CompareValue(condition->type, condition->size, value, condition->a) < 0) ||
+                         (RM_CompareValue(condition->type, condition->size, value, condition->b) > 0);
+            break;
+
+        case RM_TRIGGER_MASK:
+            is_matched = ((value & condition->a) == condition->b);
+            break;
+
+        case RM_TRIGGER_TOGGLE:
+            is_matched = (((value ^ condition->previous) & condition->a) != 0);
+            break;
+
+        default:
+            is_matched = false;
             break;
+        }
+
+        /* Every condition is read, edges need the previous value of each tick */
+        condition->previous = value;
+
+        if( pTrigger->isAnyCondition == true )
+        {
+            result = result || is_matched;
+        }
+        else
+        {
+            result = result && is_matched;
+        }
+    }
+
+    return result;
+}
+
+#endif
+
+#ifdef RM_SUPPORT_AGGREGATION
+/** 
+ * @fn void RM_FoldAggregate( RM_contents* pContents )
+ * @brief Folds the current values of the log table into their aggregates, once per RM_Task().
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ */
+void RM_FoldAggregate( RM_contents* pContents )
+{
+    RM_Aggregate* aggregate;
+    uint32_t value;
+    float    float_value;
+    float    delta;
+    float    position;
+    uint8_t  size;
+    uint8_t  bin_index;
+    uint16_t index;
+
+    /* The host did not read the aggregates for the longest period, keep them as they are */
+    if( pContents->aggregateCount == 0xFFFF )
+    {
+        return;
+    }
+
+    for( index = 0; index < pContents->log.availableIndex; index++ )
+    {
+        aggregate = &pContents->aggregate[index];
+        size = pContents->log.sizeArray[index];
+
+        value = RM_ReadValue(pContents->log.addressArray[index], size);
+        float_value = RM_GetFloatValue(aggregate->type, size, value);
+
+        /* min and max are kept sign-extended, so they compare as 4-byte values */
+        if( aggregate->type == RM_TYPE_SIGNED )
+        {
+            value = RM_ExtendSign(size, value);
+        }
+
+        if( pContents->aggregateCount == 0 )
+        {
+            aggregate->min = value;
+            aggregate->max = value;
+            aggregate->offset = float_value;
+            aggregate->sum = 0.0f;
+            aggregate->sumSquares = 0.0f;
+            memset(aggregate->bin, 0, sizeof(aggregate->bin));
+        }
+        else if( RM_CompareValue(aggregate->type, 4, value, aggregate->min) < 0 )
+        {
+            aggregate->min = value;
+        }
+        else if( RM_CompareValue(aggregate->type, 4, value, aggregate->max) > 0 )
+        {
+            aggregate->max = value;
+        }
+
+        delta = float_value - aggregate->offset;
+        aggregate->sum += delta;
+        aggregate->sumSquares += delta * delta;
+
+        if( aggregate->binCount != 0 )
+        {
+            position = (float_value - aggregate->binLower) * aggregate->binScale;
+            if( !(position >= 0.0f) )
+            {
+                bin_index = 0;
+            }
+            else if( position >= (float)aggregate->binCount )
+            {
+                bin_index = aggregate->binCount - 1;
+            }
+            else
+            {
+                bin_index = (uint8_t)position;
+            }
+
+            aggregate->bin[bin_index]++;
+        }
+    }
+
+    pContents->aggregateCount++;
+}
+
+/**
+ * @fn uint16_t RM_GetAggregateData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Builds the payload of an aggregate log frame and starts a new period.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes.
+ * @return The size of the payload, 0 if no tick has been folded yet.
+ */
+uint16_t RM_GetAggregateData( RM_contents* pContents, uint8_t payload[] )
+{
+    RM_Aggregate* aggregate;
+    uint16_t payload_index;
+    uint16_t index;
+    uint8_t  size;
+    uint8_t  bin_index;
+    float    count;
+    float    mean;
+    float    variance;
+
+    if( pContents->aggregateCount == 0 )
+    {
+        return 0;
+    }
+
+    payload[0] = (uint8_t)(pContents->aggregateCount);
+    payload[1] = (uint8_t)(pContents->aggregateCount >> 8);
+    payload_index = RM_AGGREGATE_HEADER_SIZE;
+
+    count = (float)pContents->aggregateCount;
+
+    for( index = 0; index < pContents->log.availableIndex; index++ )
+    {
+        aggregate = &pContents->aggregate[index];
+        size = pContents->log.sizeArray[index];
+
+        mean = aggregate->sum / count;
+        variance = (aggregate->sumSquares / count) - (mean * mean);
+        if( variance < 0.0f )
+        {
+            variance = 0.0f;
+        }
+        mean += aggregate->offset;
+
+        /* Little-endian, truncated to the size of the entry */
+        RM_SetUint32(&payload[payload_index], aggregate->min);
+        payload_index += size;
+        RM_SetUint32(&payload[payload_index], aggregate->max);
+        payload_index += size;
+
+        memcpy(&payload[payload_index], &mean, sizeof(mean));
+        payload_index += 4;
+        memcpy(&payload[payload_index], &variance, sizeof(variance));
+        payload_index += 4;
+
+        for( bin_index = 0; bin_index < aggregate->binCount; bin_index++ )
+        {
+            payload[payload_index++] = (uint8_t)(aggregate->bin[bin_index]);
+            payload[payload_index++] = (uint8_t)(aggregate->bin[bin_index] >> 8);
+        }
+    }
+
+    pContents->aggregateCount = 0;
+
+    return payload_index;
+}
+
+/** 
+ * @fn float RM_GetFloatValue( uint8_t type, uint8_t size, uint32_t value )
+ * @brief Converts a raw value of a variable to float as type.
+ * 
+ * @param type RM_TYPE_UNSIGNED, RM_TYPE_SIGNED or RM_TYPE_FLOAT.
+ * @param size Size of the value.
+ * @param value Raw value from RM_ReadValue().
+ * @return The value.
+ */
+float RM_GetFloatValue( uint8_t type, uint8_t size, uint32_t value )
+{
+    float float_value;
+
+    if( type == RM_TYPE_SIGNED )
+    {
+        if( size == 1 )
+        {
+            return (float)(int8_t)value;
+        }
+        else if( size == 2 )
+        {
+            return (float)(int16_t)value;
+        }
+
+        return (float)(int32_t)value;
+    }
+
+    if( type == RM_TYPE_FLOAT )
+    {
+        memcpy(&float_value, &value, sizeof(float_value));
+        return float_value;
+    }
+
+    return (float)value;
+}
+#endif
+
+#ifdef RM_SUPPORT_SCHEDULE
+/**
+ * @fn uint16_t RM_GetScheduledLogData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Builds the payload of a scheduled log frame, the schedule ID and the entries due in this period.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes.
+ * @return The size of the payload, 0 if no entry is due.
+ */
+uint16_t RM_GetScheduledLogData( RM_contents* pContents, uint8_t payload[] )
+{
+    uint16_t payload_index;
+    uint16_t index;
+    RM_PROFILE_BEGIN(profile_start);
+
+    payload[0] = pContents->logScheduleId;
+    payload_index = RM_SCHEDULE_HEADER_SIZE;
+
+    for( index = 0; index < pContents->log.availableIndex; index++ )
+    {
+        if( (pContents->logScheduleId % pContents->logDivisor[index]) == 0 )
+        {
+            payload_index += RM_GatherLogEntry( pContents->log.addressArray[index], pContents->log.sizeArray[index], &payload[payload_index] );
+        }
+    }
+
+    RM_PROFILE_END(RM_PROFILE_STAGE_GETLOG, profile_start);
+
+    if( payload_index == RM_SCHEDULE_HEADER_SIZE )
+    {
+        return 0;
+    }
+
+    return payload_index;
+}
+#endif
+
+#ifdef RM_SUPPORT_CHANGE_LOG
+/**
+ * @fn uint16_t RM_GetChangedLogData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Builds the payload of a change frame, or of a heartbeat with all entries right after a period.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes.
+ * @return The size of the payload, 0 if no entry changed.
+ */
+uint16_t RM_GetChangedLogData( RM_contents* pContents, uint8_t payload[] )
+{
+    RM_ChangeFilter* filter;
+    uint32_t value;
+    uint16_t payload_index;
+    uint16_t index;
+    uint8_t  size;
+    bool is_heartbeat;
+    bool is_changed;
+    RM_PROFILE_BEGIN(profile_start);
+
+    /* RM_Task() clears logIntervalCnt at the end of a period before sending */
+    is_heartbeat = (pContents->logIntervalCnt == 0);
+    is_changed = false;
+
+    payload_index = (pContents->log.availableIndex + 7) / 8;
+    memset(payload, 0, payload_index);
+
+    for( index = 0; index < pContents->log.availableIndex; index++ )
+    {
+        filter = &pContents->changeFilter[index];
+        size = pContents->log.sizeArray[index];
+        value = RM_ReadValue(pContents->log.addressArray[index], size);
+
+        if( (is_heartbeat == true) || (RM_IsLogEntryChanged(filter, size, value) == true) )
+        {
+            payload[index / 8] |= (uint8_t)(1 << (index % 8));
+            payload_index += RM_GatherLogEntry( pContents->log.addressArray[index], size, &payload[payload_index] );
+            filter->last = value;
+            is_changed = true;
+        }
+    }
+
+    RM_PROFILE_END(RM_PROFILE_STAGE_GETLOG, profile_start);
+
+    if( is_changed == false )
+    {
+        return 0;
+    }
+
+    return payload_index;
+}
+
+/** 
+ * @fn bool RM_IsLogEntryChanged( RM_ChangeFilter* pFilter, uint8_t size, uint32_t value )
+ * @brief Tests a value of a log entry against the value it was last sent with.
+ * 
+ * @param pFilter Pointer to RM_ChangeFilter structure.
+ * @param size Size of the entry.
+ * @param value Raw value from RM_ReadValue().
+ * @return true if the entry has to be sent.
+ */
+bool RM_IsLogEntryChanged( RM_ChangeFilter* pFilter, uint8_t size, uint32_t value )
+{
+    uint32_t last;
+    uint32_t difference;
+    float float_value;
+    float float_last;
+    float float_threshold;
+
+    if( value == pFilter->last )
+    {
+        return false;
+    }
+
+    if( pFilter->isMask == true )
+    {
+        return (((value ^ pFilter->last) & pFilter->threshold) != 0);
+    }
+
+    if( pFilter->type == RM_TYPE_FLOAT )
+    {
+        memcpy(&float_value, &value, sizeof(float_value));
+        memcpy(&float_last, &pFilter->last, sizeof(float_last));
+        memcpy(&float_threshold, &pFilter->threshold, sizeof(float_threshold));
+
+        float_value -= float_last;
+        if( float_value < 0.0f )
+        {
+            float_value = -float_value;
+        }
+
+        /* A change to or from NaN is sent as well */
+        return !(float_value <= float_threshold);
+    }
+
+    last = pFilter->last;
+    if( pFilter->type == RM_TYPE_SIGNED )
+    {
+        value = RM_ExtendSign(size, value);
+        last = RM_ExtendSign(size, last);
+
+        difference = ((int32_t)value > (int32_t)last) ? (value - last) : (last - value);
+    }
+    else
+    {
+        difference = (value > last) ? (value - last) : (last - value);
+    }
+
+    return (difference > pFilter->threshold);
+}
+#endif
+
+#ifdef RM_SUPPORT_HASH
+/** 
+ * @fn void RM_RunHash( RM_contents* pContents )
+ * @brief Hashes the next RM_HASH_SLICE_SIZE bytes of the running region hash, once per RM_Task().
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ */
+void RM_RunHash( RM_contents* pContents )
+{
+    RM_Hash* hash;
+    rm_address_t slice_size;
+    rm_address_t size;
+
+    hash = &pContents->hash;
+    if( hash->state != RM_HASH_STATE_RUNNING )
+    {
+        return;
+    }
+
+    slice_size = (hash->remaining < RM_HASH_SLICE_SIZE) ? hash->remaining : RM_HASH_SLICE_SIZE;
+
+    while( slice_size > 0 )
+    {
+        size = slice_size;
+        if( (hash->chunkSize != 0) && (hash->chunkRemaining < size) )
+        {
+            size = hash->chunkRemaining;
+        }
+
+        hash->crc = RM_UpdateCRC32(hash->crc, (const uint8_t*)(uintptr_t)hash->address, size);
+
+        if( hash->chunkSize != 0 )
+        {
+            hash->chunkCrc = RM_UpdateCRC32(hash->chunkCrc, (const uint8_t*)(uintptr_t)hash->address, size);
+            hash->chunkRemaining -= size;
+
+            /* The last chunk may be shorter */
+            if( (hash->chunkRemaining == 0) || (hash->remaining == size) )
+            {
+                hash->chunk[hash->chunkCount] = ~hash->chunkCrc;
+                hash->chunkCount++;
+                hash->chunkCrc = 0xFFFFFFFFUL;
+                hash->chunkRemaining = hash->chunkSize;
+            }
+        }
+
+        hash->address = (rm_address_t)(hash->address + size);
+        hash->remaining -= size;
+        slice_size -= size;
+    }
+
+    if( hash->remaining == 0 )
+    {
+        hash->state = RM_HASH_STATE_DONE;
+    }
+}
+
+/**
+ * @fn uint16_t RM_GetHashData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Builds the payload of the RM_EXTCODE_READ_HASH response.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes.
+ * @return The size of the payload.
+ */
+uint16_t RM_GetHashData( RM_contents* pContents, uint8_t payload[] )
+{
+    RM_Hash* hash;
+    uint16_t payload_index;
+    uint8_t  index;
+
+    hash = &pContents->hash;
+
+    payload[0] = hash->state;
+    RM_SetAddress(&payload[1], (rm_address_t)(hash->length - hash->remaining));
+    RM_SetUint32(&payload[1 + RM_ADDRESS_SIZE], ~hash->crc);
+    payload[1 + RM_ADDRESS_SIZE + 4] = hash->chunkCount;
+    payload_index = RM_HASH_HEADER_SIZE;
+
+    for( index = 0; index < hash->chunkCount; index++ )
+    {
+        RM_SetUint32(&payload[payload_index], hash->chunk[index]);
+        payload_index += 4;
+    }
+
+    return payload_index;
+}
+#endif
+
+#if defined(RM_SUPPORT_HASH) || defined(RM_SUPPORT_SNAPSHOT) || defined(RM_SUPPORT_SESSION)
+/** 
+ * @fn uint32_t RM_UpdateCRC32( uint32_t crc, const uint8_t buffer[], rm_address_t bufferSize )
+ * @brief Feeds a buffer into a running CRC-32, without the initial and final inversion.
+ * 
+ * @param crc Running CRC, 0xFFFFFFFF at the start.
+ * @param buffer[] Array containing the data.
+ * @param bufferSize Size of the buffer array.
+ * @return The running CRC, its inversion is the digest.
+ */
+uint32_t RM_UpdateCRC32( uint32_t crc, const uint8_t buffer[], rm_address_t bufferSize )
+{
+    rm_address_t index;
+
+    for( index = 0; index < bufferSize; index++ )
+    {
+        crc = (crc >> 4) ^ RM_Crc32Table[(crc ^ buffer[index]) & 0x0F];
+        crc = (crc >> 4) ^ RM_Crc32Table[(crc ^ (buffer[index] >> 4)) & 0x0F];
+    }
+
+    return crc;
+}
+#endif
+
+#ifdef RM_SUPPORT_SNAPSHOT
+/**
+ * @fn uint16_t RM_GetDiffData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Builds the payload of the RM_EXTCODE_READ_DIFF response and moves the baseline to it.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes.
+ * @return The size of the payload.
+ */
+uint16_t RM_GetDiffData( RM_contents* pContents, uint8_t payload[] )
+{
+    RM_Snapshot* snapshot;
+    uint8_t* data;
+    uint16_t payload_index;
+    uint16_t run_index;
+    uint16_t offset;
+    uint16_t run_start;
+    uint16_t scanned;
+    uint16_t size;
+    uint16_t gap;
+    uint32_t crc;
+
+    snapshot = &pContents->snapshot;
+    data = (uint8_t*)(uintptr_t)snapshot->address;
+    offset = snapshot->readOffset;
+    scanned = 0;
+    payload_index = RM_DIFF_HEADER_SIZE;
+
+    while( (offset < snapshot->length) && (scanned < RM_HASH_SLICE_SIZE) )
+    {
+        if( snapshot->blockSize == 0 )
+        {
+            if( data[offset] == snapshot->buffer[offset] )
+            {
+                offset++;
+                scanned++;
+                continue;
+            }
+
+            if( (payload_index + RM_DIFF_RUN_HEADER_SIZE + 1) > RM_SND_PAYLOAD_SIZE )
+            {
+                break;
+            }
+
+            /* A run goes on over fewer equal bytes than a run header */
+            run_start = offset;
+            run_index = payload_index + RM_DIFF_RUN_HEADER_SIZE;
+            gap = 0;
+            while( (offset < snapshot->length) &&
+                   (run_index < RM_SND_PAYLOAD_SIZE) &&
+                   ((offset - run_start) < 0xFF) )
+            {
+                if( data[offset] != snapshot->buffer[offset] )
+                {
+                    gap = 0;
+                }
+                else if( (gap + 1) < RM_DIFF_RUN_HEADER_SIZE )
+                {
+                    gap++;
+                }
+                else
+                {
+                    break;
+                }
+
+                snapshot->buffer[offset] = data[offset];
+                payload[run_index] = snapshot->buffer[offset];
+                run_index++;
+                offset++;
+            }
+
+            /* Trailing equal bytes are not sent */
+            offset -= gap;
+            size = offset - run_start;
+            scanned += size;
+        }
+        else
+        {
+            size = ((snapshot->length - offset) < snapshot->blockSize) ? (snapshot->length - offset) : snapshot->blockSize;
+            scanned += size;
+
+            crc = ~RM_UpdateCRC32(0xFFFFFFFFUL, &data[offset], size);
+            if( crc == RM_GetUint32(&snapshot->buffer[(offset / snapshot->blockSize) * 4]) )
+            {
+                offset += size;
+                continue;
+            }
+
+            if( (payload_index + RM_DIFF_RUN_HEADER_SIZE + size) > RM_SND_PAYLOAD_SIZE )
+            {
+                break;
+            }
+
+            /* The baseline is the CRC of the bytes sent, the block may change while it is copied */
+            run_start = offset;
+            memcpy(&payload[payload_index + RM_DIFF_RUN_HEADER_SIZE], &data[offset], size);
+            crc = ~RM_UpdateCRC32(0xFFFFFFFFUL, &payload[payload_index + RM_DIFF_RUN_HEADER_SIZE], size);
+            RM_SetUint32(&snapshot->buffer[(offset / snapshot->blockSize) * 4], crc);
+            offset += size;
+        }
+
+        payload[payload_index] = (uint8_t)(run_start);
+        payload[payload_index + 1] = (uint8_t)(run_start >> 8);
+        payload[payload_index + 2] = (uint8_t)size;
+        payload_index += RM_DIFF_RUN_HEADER_SIZE + size;
+    }
+
+    payload[0] = (uint8_t)(offset);
+    payload[1] = (uint8_t)(offset >> 8);
+
+    return payload_index;
+}
+#endif
+
+#ifdef RM_SUPPORT_COMPRESSION
+/**
+ * @fn uint16_t RM_GetCompressedData( RM_contents* pContents, uint8_t payload[] )
+ * @brief Builds the payload of the RM_EXTCODE_COMPRESSED_DUMP response from RM_contents::block.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @param payload[] Array of RM_SND_PAYLOAD_SIZE bytes.
+ * @return The size of the payload.
+ */
+uint16_t RM_GetCompressedData( RM_contents* pContents, uint8_t payload[] )
+{
+    uint8_t* data;
+    uint16_t payload_index;
+    uint16_t literal_index;
+    uint16_t offset;
+    uint16_t end;
+    uint16_t count;
+    bool is_literal;
+
+    data = (uint8_t*)(uintptr_t)pContents->block.address;
+    offset = 0;
+    end = (pContents->block.length < RM_COMPRESS_SCAN_SIZE) ? pContents->block.length : RM_COMPRESS_SCAN_SIZE;
+    payload_index = RM_RLE_HEADER_SIZE;
+    literal_index = 0;
+    is_literal = false;
+
+    /* A run reaching end goes on in the next response */
+    while( offset < end )
+    {
+        count = 1;
+        while( ((offset + count) < end) &&
+               (data[offset + count] == data[offset]) )
+        {
+            count++;
+        }
+
+        if( count >= RM_RLE_REPEAT_MIN )
+        {
+            if( count > RM_RLE_REPEAT_MAX )
+            {
+                if( (payload_index + 4) > RM_SND_PAYLOAD_SIZE )
+                {
+                    break;
+                }
+
+                payload[payload_index++] = RM_RLE_LONG_REPEAT;
+                payload[payload_index++] = (uint8_t)(count);
+                payload[payload_index++] = (uint8_t)(count >> 8);
+            }
+            else
+            {
+                if( (payload_index + 2) > RM_SND_PAYLOAD_SIZE )
+                {
+                    break;
+                }
+
+                payload[payload_index++] = (uint8_t)(RM_RLE_REPEAT + count - RM_RLE_REPEAT_MIN);
+            }
+
+            payload[payload_index++] = data[offset];
+            offset += count;
+            is_literal = false;
+            continue;
+        }
+
+        /* Shorter runs are appended to the open literal, or open a new one */
+        if( (is_literal == false) || (payload[literal_index] == (RM_RLE_LITERAL_MAX - 1)) )
+        {
+            if( (payload_index + 2) > RM_SND_PAYLOAD_SIZE )
+            {
+                break;
+            }
+
+            literal_index = payload_index;
+            payload[payload_index++] = 0;
+            is_literal = true;
+        }
+        else
+        {
+            if( (payload_index + 1) > RM_SND_PAYLOAD_SIZE )
+            {
+                break;
+            }
+
+            payload[literal_index]++;
+        }
+
+        payload[payload_index++] = data[offset];
+        offset++;
+    }
+
+    payload[0] = (uint8_t)(offset);
+    payload[1] = (uint8_t)(offset >> 8);
+
+    return payload_index;
+}
+#endif
+
+#if defined(RM_SUPPORT_TRIGGER) || defined(RM_SUPPORT_AGGREGATION) || defined(RM_SUPPORT_CHANGE_LOG)
+/** 
+ * @fn uint32_t RM_ReadValue( rm_address_t address, uint8_t size )
+ * @brief Reads a variable of 1, 2 or 4 bytes, zero-extended to 32 bits.
+ * 
+ * @param address Address of the variable.
+ * @param size Size of the variable.
+ * @return The raw value.
+ */
+uint32_t RM_ReadValue( rm_address_t address, uint8_t size )
+{
+    switch( size )
+    {
+    case 1:
+        return *(uint8_t*)(uintptr_t)address;
+
+    case 2:
+        return *(uint16_t*)(uintptr_t)address;
+
+    default:
+        return *(uint32_t*)(uintptr_t)address;
+    }
+}
+
+/** 
+ * @fn int8_t RM_CompareValue( uint8_t type, uint8_t size, uint32_t value, uint32_t threshold )
+ * @brief Compares a raw value with a threshold as type.
+ * 
+ * Signed values are sign-extended from their size, the threshold is a full 32-bit value.
+ * 
+ * @param type RM_TYPE_UNSIGNED, RM_TYPE_SIGNED or RM_TYPE_FLOAT.
+ * @param size Size of the value.
+ * @param value Raw value from RM_ReadValue().
+ * @param threshold Raw threshold.
+ * @return -1, 0 or 1 as value is below, equal to or above threshold.
+ */
+int8_t RM_CompareValue( uint8_t type, uint8_t size, uint32_t value, uint32_t threshold )
+{
+    int32_t signed_value;
+    float float_value;
+    float float_threshold;
+
+    if( type == RM_TYPE_SIGNED )
+    {
+        signed_value = (int32_t)value;
+        if( size == 1 )
+        {
+            signed_value = (int8_t)value;
+        }
+        else if( size == 2 )
+        {
+            signed_value = (int16_t)value;
+        }
+
+        return (signed_value < (int32_t)threshold) ? -1 : ((signed_value > (int32_t)threshold) ? 1 : 0);
+    }
+
+    if( type == RM_TYPE_FLOAT )
+    {
+        memcpy(&float_value, &value, sizeof(float_value));
+        memcpy(&float_threshold, &threshold, sizeof(float_threshold));
+
+        return (float_value < float_threshold) ? -1 : ((float_value > float_threshold) ? 1 : 0);
+    }
+
+    return (value < threshold) ? -1 : ((value > threshold) ? 1 : 0);
+}
+
+/** 
+ * @fn uint32_t RM_ExtendSign( uint8_t size, uint32_t value )
+ * @brief Sign-extends a raw signed value of 1 or 2 bytes to 32 bits.
+ * 
+ * @param size Size of the value.
+ * @param value Raw value from RM_ReadValue().
+ * @return The value as a 32-bit two's complement.
+ */
+uint32_t RM_ExtendSign( uint8_t size, uint32_t value )
+{
+    if( size == 1 )
+    {
+        return (uint32_t)(int32_t)(int8_t)value;
+    }
+    else if( size == 2 )
+    {
+        return (uint32_t)(int32_t)(int16_t)value;
+    }
+
+    return value;
+}
+#endif
+
+/** 
+ * @fn rm_address_t RM_GetAddress( uint8_t buffer[] )
+ * @brief Reads a little-endian address of RM_ADDRESS_SIZE bytes from a received frame.
+ * 
+ * @param buffer[] Array pointing to the first byte of the address.
+ * @return The address.
+ */
+rm_address_t RM_GetAddress( uint8_t buffer[] )
+{
+    uint8_t index;
+    rm_address_t address;
+
+    address = 0;
+    for( index = RM_ADDRESS_SIZE; index > 0; index-- )
+    {
+        address = (rm_address_t)(address << 8);
+        address |= (rm_address_t)buffer[index - 1];
+    }
+
+    return address;
+}
+
+/** 
+ * @fn uint32_t RM_GetUint32( uint8_t buffer[] )
+ * @brief Reads a little-endian 32-bit value, such as a token or a threshold, from a received frame.
+ * 
+ * @param buffer[] Array pointing to the first byte of the value.
+ * @return The value.
+ */
+uint32_t RM_GetUint32( uint8_t buffer[] )
+{
+    uint32_t value;
+
+    value  = buffer[3];
+    value  = value << 8;
+    value |= buffer[2];
+    value  = value << 8;
+    value |= buffer[1];
+    value  = value << 8;
+    value |= buffer[0];
+
+    return value;
+}
+
+/** 
+ * @fn void RM_SetUint32( uint8_t buffer[], uint32_t value )
+ * @brief Writes a little-endian 32-bit value into a response.
+ * 
+ * @param buffer[] Array pointing to the first byte of the value, 4 bytes are written.
+ * @param value The value.
+ */
+void RM_SetUint32( uint8_t buffer[], uint32_t value )
+{
+    buffer[0] = (uint8_t)(value);
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+/** 
+ * @fn void RM_SetAddress( uint8_t buffer[], rm_address_t address )
+ * @brief Writes a little-endian address of RM_ADDRESS_SIZE bytes into a response.
+ * 
+ * @param buffer[] Array pointing to the first byte of the address.
+ * @param address The address.
+ */
+void RM_SetAddress( uint8_t buffer[], rm_address_t address )
+{
+    uint8_t index;
+
+    for( index = 0; index < RM_ADDRESS_SIZE; index++ )
+    {
+        buffer[index] = (uint8_t)address;
+        address = (rm_address_t)(address >> 8);
+    }
+}
+
+/** 
+ * @fn uint8_t RM_GetCRC( uint8_t buffer[], uint16_t bufferSize )
+ * @brief Calculates the CRC (Cyclic Redundancy Check) for a given buffer.
+ * 
+ * @param buffer[] Array containing the data to calculate CRC.
+ * @param bufferSize Size of the buffer array.
+ * @return The calculated CRC value.
+ */
+uint8_t RM_GetCRC( uint8_t buffer[], uint16_t bufferSize )
+{
+    uint16_t index;
+    uint8_t crc_index;
+    uint8_t crc;
+    RM_PROFILE_BEGIN(profile_start);
+
+    crc = 0;
+
+    for( index = 0; index < bufferSize; index++ )
+    {
+      crc_index = crc ^ buffer[ index ];
+        crc = RM_CrcTable[ crc_index ];
+    }
+
+    RM_PROFILE_END(RM_PROFILE_STAGE_CRC, profile_start);
+    return crc;
 
+}
+
+/** 
+ * @fn uint8_t RM_VerifyCheck( RM_contents* pContents )
+ * @brief Checks the received frame with the frame check in use.
+ * 
+ * Passkey and RM_EXTCODE_RESUME_SESSION requests and the frames before the approval always use
+ * RM_FRAME_CHECK_CRC8, so a host can connect or resume whatever the previous connection chose.
+ * 
+ * @param pContents Pointer to RM_contents structure.
+ * @return The size of the check at the end of the frame, 0 if the frame is corrupted.
+ */
+uint8_t RM_VerifyCheck( RM_contents* pContents )
+{
+    uint8_t* buffer;
+    uint16_t length;
+#ifdef RM_SUPPORT_WIDE_CRC
+    uint8_t opcode;
+    bool is_connect;
 #endif
-        default:
-            break;
 
+    buffer = pContents->rxData.buffer;
+    length = pContents->rxData.length;
+
+#ifdef RM_SUPPORT_WIDE_CRC
+    opcode = buffer[RM_FRAME_SEQCODE] & (uint8_t)0x0F;
+    is_connect = (opcode == 0x06) ||
+                 ((opcode == RM_OPCODE_EXTENDED) && (length >= (1 + 1)) &&
+                  (buffer[RM_FRAME_PAYLOAD + 0] == RM_EXTCODE_RESUME_SESSION));
+
+    if( (pContents->isApproved == true) && (is_connect == false) )
+    {
+        if( pContents->frameCheck == RM_FRAME_CHECK_CRC16 )
+        {
+            if( (length < (1 + 2)) ||
+                (RM_GetCRC16(buffer, length - 2) != (uint16_t)(buffer[length - 2] | ((uint16_t)buffer[length - 1] << 8))) )
+            {
+                return 0;
+            }
+
+            return 2;
         }
 
+        if( pContents->frameCheck == RM_FRAME_CHECK_CRC32C )
+        {
+            if( (length < (1 + 4)) ||
+                (RM_GetCRC32C(buffer, length - 4) != RM_GetUint32(&buffer[length - 4])) )
+            {
+                return 0;
+            }
+
+            return 4;
+        }
     }
+#endif
 
-    return payload_index;
+    if( RM_GetCRC(buffer, length) != 0 )
+    {
+        return 0;
+    }
+
+    return 1;
 }
 
 /** 
- * @fn uint16_t RM_GetBlockData( RM_Data* pData, RM_TransmittingData* pTransmitData )
- * @brief Retrieves block data for transmission.
+ * @fn uint16_t RM_AppendCheck( RM_contents* pContents, uint16_t frameSize )
+ * @brief Appends the frame check in use to the frame in RM_contents::txData.
  * 
- * @param pData Pointer to RM_Data structure.
- * @param pTransmitData Pointer to RM_TransmittingData structure.
- * @return The size of the block data prepared for transmission.
+ * @param pContents Pointer to RM_contents structure.
+ * @param frameSize Size of the frame without check.
+ * @return The size of the frame with check.
  */
-uint16_t RM_GetBlockData( RM_Data* pData, RM_TransmittingData* pTransmitData )
+uint16_t RM_AppendCheck( RM_contents* pContents, uint16_t frameSize )
 {
-    uint16_t index;
-    uint8_t* ptr_data;
+    uint8_t* buffer;
 
-    ptr_data = (uint8_t*)pData->address;
-    for( index = 0; index < pData->length; index++ )
+    buffer = pContents->txData.buffer;
+
+#ifdef RM_SUPPORT_WIDE_CRC
+    if( pContents->frameCheck == RM_FRAME_CHECK_CRC16 )
     {
-        pTransmitData->buffer[RM_FRAME_PAYLOAD + index] = *ptr_data;
-        ptr_data++;
+        uint16_t crc = RM_GetCRC16(buffer, frameSize);
+        buffer[frameSize] = (uint8_t)crc;
+        buffer[frameSize + 1] = (uint8_t)(crc >> 8);
+        return frameSize + 2;
     }
 
-    return index;
+    if( pContents->frameCheck == RM_FRAME_CHECK_CRC32C )
+    {
+        RM_SetUint32(&buffer[frameSize], RM_GetCRC32C(buffer, frameSize));
+        return frameSize + 4;
+    }
+#endif
+
+    buffer[frameSize] = RM_GetCRC(buffer, frameSize);
+    return frameSize + 1;
 }
 
+#ifdef RM_SUPPORT_WIDE_CRC
 /** 
- * @fn uint8_t RM_GetCRC( uint8_t buffer[], uint8_t bufferSize )
- * @brief Calculates the CRC (Cyclic Redundancy Check) for a given buffer.
+ * @fn uint16_t RM_GetCRC16( const uint8_t buffer[], uint16_t bufferSize )
+ * @brief Calculates the CRC-16/XMODEM of a buffer.
  * 
  * @param buffer[] Array containing the data to calculate CRC.
  * @param bufferSize Size of the buffer array.
  * @return The calculated CRC value.
  */
-uint8_t RM_GetCRC( uint8_t buffer[], uint8_t bufferSize )
+uint16_t RM_GetCRC16( const uint8_t buffer[], uint16_t bufferSize )
 {
-    uint8_t index;
-    uint8_t crc_index;
-    uint8_t crc;
+    uint16_t index;
+    uint16_t crc;
+    RM_PROFILE_BEGIN(profile_start);
 
     crc = 0;
 
     for( index = 0; index < bufferSize; index++ )
     {
-      crc_index = crc ^ buffer[ index ];
-        crc = RM_CrcTable[ crc_index ];
+#ifdef __AVR__
+        crc = _crc_xmodem_update(crc, buffer[index]);
+#else
+        crc = (uint16_t)(crc << 8) ^ RM_Crc16Table[(uint8_t)(crc >> 8) ^ buffer[index]];
+#endif
     }
 
+    RM_PROFILE_END(RM_PROFILE_STAGE_CRC, profile_start);
     return crc;
+}
+
+/** 
+ * @fn uint32_t RM_GetCRC32C( const uint8_t buffer[], uint16_t bufferSize )
+ * @brief Calculates the CRC-32C of a buffer, with the CRC instructions of the CPU where available.
+ * 
+ * @param buffer[] Array containing the data to calculate CRC.
+ * @param bufferSize Size of the buffer array.
+ * @return The calculated CRC value.
+ */
+uint32_t RM_GetCRC32C( const uint8_t buffer[], uint16_t bufferSize )
+{
+#ifndef __ARM_FEATURE_CRC32
+    uint16_t index;
+#endif
+    uint32_t crc;
+    RM_PROFILE_BEGIN(profile_start);
+
+    crc = 0xFFFFFFFFUL;
+
+#ifdef __ARM_FEATURE_CRC32
+    crc = RM_UpdateCRC32CHardware(crc, buffer, bufferSize);
+#else
+#ifdef __x86_64__
+    /* SSE4.2 is not part of the x86-64 baseline, it is checked at run time */
+    if( __builtin_cpu_supports("sse4.2") )
+    {
+        crc = RM_UpdateCRC32CHardware(crc, buffer, bufferSize);
+    }
+    else
+#endif
+    {
+        for( index = 0; index < bufferSize; index++ )
+        {
+#ifdef __AVR__
+            crc = (crc >> 4) ^ RM_Crc32cTable[(crc ^ buffer[index]) & 0x0F];
+            crc = (crc >> 4) ^ RM_Crc32cTable[(crc ^ (buffer[index] >> 4)) & 0x0F];
+#else
+            crc = (crc >> 8) ^ RM_Crc32cTable[(uint8_t)crc ^ buffer[index]];
+#endif
+        }
+    }
+#endif
+
+    RM_PROFILE_END(RM_PROFILE_STAGE_CRC, profile_start);
+    return ~crc;
+}
+
+#if defined(__x86_64__) || defined(__ARM_FEATURE_CRC32)
+/** 
+ * @fn uint32_t RM_UpdateCRC32CHardware( uint32_t crc, const uint8_t buffer[], uint16_t bufferSize )
+ * @brief Continues a CRC-32C with the SSE4.2 or ARMv8 CRC instructions, a word at a time.
+ * 
+ * @param crc CRC so far, without the final inversion.
+ * @param buffer[] Array containing the data to calculate CRC.
+ * @param bufferSize Size of the buffer array.
+ * @return The updated CRC value.
+ */
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+#endif
+uint32_t RM_UpdateCRC32CHardware( uint32_t crc, const uint8_t buffer[], uint16_t bufferSize )
+{
+#if defined(__x86_64__)
+    uint64_t word;
 
+    while( bufferSize >= sizeof(word) )
+    {
+        memcpy(&word, buffer, sizeof(word));
+        crc = (uint32_t)_mm_crc32_u64(crc, word);
+        buffer += sizeof(word);
+        bufferSize -= sizeof(word);
+    }
+
+    while( bufferSize > 0 )
+    {
+        crc = _mm_crc32_u8(crc, *buffer);
+        buffer++;
+        bufferSize--;
+    }
+#else
+    uint32_t word;
+
+    while( bufferSize >= sizeof(word) )
+    {
+        memcpy(&word, buffer, sizeof(word));
+        crc = __crc32cw(crc, word);
+        buffer += sizeof(word);
+        bufferSize -= sizeof(word);
+    }
+
+    while( bufferSize > 0 )
+    {
+        crc = __crc32cb(crc, *buffer);
+        buffer++;
+        bufferSize--;
+    }
+#endif
+
+    return crc;
 }
+#endif
+#endif
 
 /** 
  * @fn bool RM_EncodeTransmitData( RM_TransmittingData* pTransmitData, uint8_t* pData )
@@ -1188,6 +4813,13 @@ bool RM_EncodeTransmitData( RM_TransmittingData* pTransmitData, uint8_t* pData )
         return false;
     }
 
+#ifdef RM_SUPPORT_COBS
+    if( pTransmitData->framing == RM_FRAMING_COBS )
+    {
+        return RM_EncodeCobsData(pTransmitData, pData);
+    }
+#endif
+
     if( pTransmitData->status == RM_TRANSMIT_STATUS_READY )
     {
         pTransmitData->status = RM_TRANSMIT_STATUS_BUSY;
@@ -1231,5 +4863,264 @@ bool RM_EncodeTransmitData( RM_TransmittingData* pTransmitData, uint8_t* pData )
     return is_available;
 }
 
+#ifdef RM_SUPPORT_COBS
+/** 
+ * @fn void RM_DecodeCobsData(RM_ReceivedData* pReceivedData, uint8_t data)
+ * @brief Decodes a received byte of a COBS frame.
+ * 
+ * Frames are delimited by 0x00. Each group starts with a code byte and holds code - 1 data bytes,
+ * followed by a zero unless the code is 0xFF or the group ends the frame. BUSY_ESCAPE stands for
+ * a code byte being due, BUSY_NORMAL for data bytes.
+ * 
+ * @param pReceivedData Pointer to RM_ReceivedData structure.
+ * @param data Received data byte.
+ */
+void RM_DecodeCobsData( RM_ReceivedData* pReceivedData, uint8_t data )
+{
+    if(pReceivedData->status == RM_RECEIVED_STATUS_READY)
+    {
+        if( data == 0x00 )
+        {
+            pReceivedData->status = RM_RECEIVED_STATUS_BUSY_ESCAPE;
+            pReceivedData->cobsCode = 0xFF;     // no zero before the first group
+        }
+    }
+    else if(pReceivedData->status == RM_RECEIVED_STATUS_BUSY_ESCAPE)
+    {
+        if( data == 0x00 )
+        {
+            if( pReceivedData->length > 0 )
+            {
+                /* End COBS Frame */
+                pReceivedData->status = RM_RECEIVED_STATUS_COMPLETE;
+            }
+            else
+            {
+                /* Last delimiter might be Start of Frame */
+                pReceivedData->cobsCode = 0xFF;
+            }
+            return;
+        }
+
+        /* The previous group stood for a zero, now that the frame goes on */
+        if( pReceivedData->cobsCode != 0xFF )
+        {
+            if( pReceivedData->length >= RM_RCV_FRAME_BUFF_SIZE )
+            {
+                RM_STATISTICS_COUNT(pReceivedData->purgedCnt);
+                RM_ClearReceivedState(pReceivedData);
+                return;
+            }
+
+            pReceivedData->buffer[pReceivedData->length] = 0x00;
+            pReceivedData->length++;
+        }
+
+        pReceivedData->cobsCode = data;
+        pReceivedData->cobsRemaining = data - 1;
+        if( pReceivedData->cobsRemaining > 0 )
+        {
+            pReceivedData->status = RM_RECEIVED_STATUS_BUSY_NORMAL;
+        }
+    }
+    else if(pReceivedData->status == RM_RECEIVED_STATUS_BUSY_NORMAL)
+    {
+        if( data == 0x00 )
+        {
+            /* Purge the truncated frame, the delimiter starts the next one */
+            RM_STATISTICS_COUNT(pReceivedData->purgedCnt);
+            pReceivedData->status = RM_RECEIVED_STATUS_BUSY_ESCAPE;
+            pReceivedData->length = 0;
+            pReceivedData->cobsCode = 0xFF;
+            return;
+        }
+
+        if( pReceivedData->length >= RM_RCV_FRAME_BUFF_SIZE )
+        {
+            RM_STATISTICS_COUNT(pReceivedData->purgedCnt);
+            RM_ClearReceivedState(pReceivedData);
+            return;
+        }
+
+        pReceivedData->buffer[pReceivedData->length] = data;
+        pReceivedData->length++;
+
+        pReceivedData->cobsRemaining--;
+        if( pReceivedData->cobsRemaining == 0 )
+        {
+            pReceivedData->status = RM_RECEIVED_STATUS_BUSY_ESCAPE;
+        }
+    }
+}
+
+/** 
+ * @fn bool RM_EncodeCobsData( RM_TransmittingData* pTransmitData, uint8_t* pData )
+ * @brief Encodes the next byte of a COBS frame, delimited by 0x00 on both ends.
+ * 
+ * The buffer is not modified, the code byte of a group is found by scanning for its zero.
+ * 
+ * @param pTransmitData Pointer to RM_TransmittingData structure.
+ * @param pData Pointer to store the encoded byte.
+ * @return true if there is data to transmit, false otherwise.
+ */
+bool RM_EncodeCobsData( RM_TransmittingData* pTransmitData, uint8_t* pData )
+{
+    uint16_t index;
+    uint16_t limit;
+
+    if( pTransmitData->status == RM_TRANSMIT_STATUS_READY )
+    {
+        pTransmitData->status = RM_TRANSMIT_STATUS_BUSY;
+        pTransmitData->currentIndex = 0;
+        pTransmitData->cobsCode = 0;
+        *pData = 0x00;
+        return true;
+    }
+
+    if( pTransmitData->status == RM_TRANSMIT_STATUS_CLOSING )
+    {
+        pTransmitData->status = RM_TRANSMIT_STATUS_COMPLETE;
+        *pData = 0x00;
+        return false;
+    }
+
+    if( (pTransmitData->cobsCode != 0) && (pTransmitData->currentIndex == pTransmitData->cobsEnd) )
+    {
+        if( pTransmitData->cobsEnd >= pTransmitData->maxIndex )
+        {
+            pTransmitData->status = RM_TRANSMIT_STATUS_CLOSING;
+            *pData = 0x00;
+            return true;
+        }
+
+        /* The group ended on a zero, which its code stands for, or it was full */
+        if( pTransmitData->cobsCode != 0xFF )
+        {
+            pTransmitData->currentIndex++;
+        }
+        pTransmitData->cobsCode = 0;
+    }
+
+    if( pTransmitData->cobsCode == 0 )
+    {
+        index = pTransmitData->currentIndex;
+        limit = index + 0xFE;
+        if( limit > pTransmitData->maxIndex )
+        {
+            limit = pTransmitData->maxIndex;
+        }
+
+        while( (index < limit) && (pTransmitData->buffer[index] != 0x00) )
+        {
+            index++;
+        }
+
+        pTransmitData->cobsEnd = index;
+        pTransmitData->cobsCode = (uint8_t)(index - pTransmitData->currentIndex + 1);
+        *pData = pTransmitData->cobsCode;
+        return true;
+    }
+
+    *pData = pTransmitData->buffer[pTransmitData->currentIndex];
+    pTransmitData->currentIndex++;
+    return true;
+}
+#endif
+
+#ifdef RM_SUPPORT_PROFILING
+/** 
+ * @fn void RM_InitializeProfile( void )
+ * @brief Starts the tick source of the profiler and clears all records.
+ */
+void RM_InitializeProfile( void )
+{
+#if defined(RM_PROFILE_TICK_TIMER1)
+    TCCR1A = 0;
+    TCCR1B = (1 << CS10);
+#elif defined(RM_PROFILE_TICK_DWT)
+    *(volatile uint32_t*)0xE000EDFCUL |= (1UL << 24);   /* DEMCR.TRCENA */
+    *(volatile uint32_t*)0xE0001004UL = 0;              /* DWT_CYCCNT */
+    *(volatile uint32_t*)0xE0001000UL |= 1UL;           /* DWT_CTRL.CYCCNTENA */
+#endif
+
+    memset(RM_profileRecord, 0, sizeof(RM_profileRecord));
+}
+
+/** 
+ * @fn void RM_RecordProfile( RM_ProfileStage stage, uint32_t ticks )
+ * @brief Accumulates a measured duration.
+ * 
+ * @param stage Profiled stage.
+ * @param ticks Duration in RM_PROFILE_TICK_HZ ticks.
+ */
+void RM_RecordProfile( RM_ProfileStage stage, uint32_t ticks )
+{
+    RM_ProfileRecord* record;
+    uint8_t bin;
+    uint32_t limit;
+
+    if( stage >= RM_PROFILE_STAGE_NUM )
+    {
+        return;
+    }
+
+    record = &RM_profileRecord[stage];
+
+    if( record->count == 0 || ticks < record->min )
+    {
+        record->min = ticks;
+    }
+
+    if( ticks > record->max )
+    {
+        record->max = ticks;
+    }
+
+    record->total += ticks;
+    record->count++;
+
+    bin = 0;
+    limit = 4;
+    while( (bin < (RM_PROFILE_HISTOGRAM_SIZE - 1)) && (ticks >= limit) )
+    {
+        bin++;
+        limit = limit << 2;
+    }
+    record->histogram[bin]++;
+}
+
+/** 
+ * @fn bool RM_GetProfile( RM_ProfileStage stage, RM_ProfileRecord* pRecord )
+ * @brief Copies the record of a profiled stage.
+ * 
+ * @param stage Profiled stage.
+ * @param pRecord Pointer to store the record.
+ * @return true if stage is valid, false otherwise.
+ */
+bool RM_GetProfile( RM_ProfileStage stage, RM_ProfileRecord* pRecord )
+{
+    if( stage >= RM_PROFILE_STAGE_NUM )
+    {
+        return false;
+    }
+
+    *pRecord = RM_profileRecord[stage];
+    return true;
+}
+
+#ifdef __linux__
+/** 
+ * @fn uint32_t RM_GetProfileTick( void )
+ * @brief Returns CLOCK_MONOTONIC in nanoseconds, truncated to 32 bits.
+ */
+uint32_t RM_GetProfileTick( void )
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+#endif
+#endif
 
 /*-- end of file --*/
@@ -8,33 +8,193 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#define RM_FLASH                        PROGMEM
+#define RM_FLASH_READ(dst, src, size)   memcpy_P((dst), (src), (size))
+#else
+#define RM_FLASH
+#define RM_FLASH_READ(dst, src, size)   memcpy((dst), (src), (size))
+#endif
+
 
 #define RM_SUPPORT_64BIT
+#define RM_SUPPORT_STATISTICS
+//#define RM_SUPPORT_PROFILING    // measures RM hot path stages, see RM_ProfileRecord
+#define RM_SUPPORT_REGISTRY     // self-describing variable table, see RM_RegistryEntry
+#define RM_SUPPORT_ACCESS_CHECK // host addresses are checked against RM_AccessRegion tables
+#define RM_SUPPORT_SESSION      // log table and period saved through a storage hook, see RM_SessionRecord
+#define RM_SUPPORT_LOG_PROFILE  // named log tables switched by one request, see RM_LogProfile
+#define RM_SUPPORT_ASYNC_BYPASS // bypass functions may answer later through RM_CompleteBypass()
+#define RM_SUPPORT_COMMAND_TABLE // bypass sub-commands dispatched by ID, see rm_command_function_t
+/* The features below are left out by default, their buffers do not fit the 2 KB of an ATmega328P together.
+   Define them here or on the command line. */
+//#define RM_SUPPORT_TRIGGER      // conditional capture of the log table around an event, see RM_Trigger
+//#define RM_SUPPORT_AGGREGATION  // statistics of every tick sent in place of log samples, see RM_Aggregate
+//#define RM_SUPPORT_SCHEDULE     // per-entry log rates, see RM_contents::logDivisor
+//#define RM_SUPPORT_CHANGE_LOG   // entries sent as soon as they change beyond a deadband, see RM_ChangeFilter
+//#define RM_SUPPORT_HASH         // CRC-32 of memory ranges computed across RM_Task() calls, see RM_Hash
+//#define RM_SUPPORT_SNAPSHOT     // dumps of the bytes changed since a baseline, see RM_Snapshot
+//#define RM_SUPPORT_COMPRESSION  // run-length compressed dumps, decoded by tools/rmRle
+//#define RM_SUPPORT_COBS         // COBS framing negotiated by RM_EXTCODE_SET_FRAMING, see RM_Framing
+//#define RM_SUPPORT_WIDE_CRC     // CRC-16 or CRC-32C frame check chosen by the passkey request, see RM_FrameCheck
 
 #ifdef __AVR__              //This statement for AVR
 #define RM_ADDRESS_2BYTE
 #elif defined(__arm__)      //This statement for ARM
 #define RM_ADDRESS_4BYTE
+#elif defined(__x86_64__) || defined(__aarch64__)   //This statement for 64-bit Linux processes
+#define RM_ADDRESS_8BYTE
 #else
 #define RM_ADDRESS_4BYTE    //You can change address width according to your application
 #endif
 
+#if defined(RM_ADDRESS_8BYTE)
+typedef uint64_t rm_address_t;
+#define RM_ADDRESS_SIZE         8
+#elif defined(RM_ADDRESS_4BYTE)
+typedef uint32_t rm_address_t;
+#define RM_ADDRESS_SIZE         4
+#else
+typedef uint16_t rm_address_t;
+#define RM_ADDRESS_SIZE         2
+#endif
+#define RM_ADDRESS_MAX          ((rm_address_t)~(rm_address_t)0)
+
+#ifdef RM_SUPPORT_PROFILING
+/* Tick source of the profiler. Define RM_PROFILE_GET_TICK() and RM_PROFILE_TICK_HZ to use your own timer. */
+#ifndef RM_PROFILE_GET_TICK
+#if defined(__AVR__)        //Timer1 without prescaler, it must not be used by the application
+#include <avr/io.h>
+typedef uint16_t rm_profile_tick_t;
+#define RM_PROFILE_GET_TICK()   (TCNT1)
+#define RM_PROFILE_TICK_HZ      F_CPU
+#define RM_PROFILE_TICK_TIMER1
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)  //DWT CYCCNT
+typedef uint32_t rm_profile_tick_t;
+#define RM_PROFILE_GET_TICK()   (*(volatile uint32_t*)0xE0001004UL)
+#define RM_PROFILE_TICK_HZ      SystemCoreClock
+#define RM_PROFILE_TICK_DWT
+#elif defined(__linux__)    //clock_gettime(CLOCK_MONOTONIC) in nanoseconds
+typedef uint32_t rm_profile_tick_t;
+#define RM_PROFILE_GET_TICK()   RM_GetProfileTick()
+#define RM_PROFILE_TICK_HZ      1000000000UL
+#else
+#error "RM_SUPPORT_PROFILING requires RM_PROFILE_GET_TICK() and RM_PROFILE_TICK_HZ for this target"
+#endif
+#else
+typedef uint32_t rm_profile_tick_t;
+#endif
+#endif
+
 /*-- begin: definitions --*/
 #define RM_LOG_FACTOR_MAX       32
 #define RM_SND_PAYLOAD_SIZE     (RM_LOG_FACTOR_MAX*4)
-#define RM_SND_FRAME_BUFF_SIZE  (RM_SND_PAYLOAD_SIZE+2)
+#ifdef RM_SUPPORT_WIDE_CRC
+#define RM_CHECK_SIZE_MAX       4       /* CRC-32C */
+#else
+#define RM_CHECK_SIZE_MAX       1
+#endif
+#define RM_SND_FRAME_BUFF_SIZE  (RM_SND_PAYLOAD_SIZE+2+RM_CHECK_SIZE_MAX)  /* seqcode, payload, the extra byte of log frames, check */
 
-#define RM_RCV_FRAME_BUFF_SIZE  32
+/* A received frame holds the sequence code, the payload and the CRC. Override it at build time if needed. */
+#ifndef RM_RCV_FRAME_BUFF_SIZE
+#ifdef __AVR__
+#define RM_RCV_FRAME_BUFF_SIZE  32      /* a whole log table fits with run-length ranges only */
+#else
+#define RM_RCV_FRAME_BUFF_SIZE  (1 + 1 + RM_LOG_FACTOR_MAX * (2 + RM_ADDRESS_SIZE) + RM_CHECK_SIZE_MAX)   /* any RM_EXTCODE_SETLOG_TABLE frame */
+#endif
+#endif
 
 #define RM_RCV_TIMEOUT_CNT      100     // ms
 #define RM_REQ_TIMEOUT_CNT      2000    // ms
 #define RM_SND_DEFAULT_CNT      500     // ms
 
+/* Framing after reset and after RM_REQ_TIMEOUT_CNT without a valid frame. RM Classic speaks RM_FRAMING_SLIP only. */
+#ifndef RM_FRAMING_DEFAULT
+#define RM_FRAMING_DEFAULT      RM_FRAMING_SLIP
+#endif
+
+#define RM_REGISTRY_NAME_SIZE       16  /* names are truncated to this size, without terminator if it is full */
+
+#define RM_PROFILE_HISTOGRAM_SIZE   8   /* bin n counts durations below 4^(n+1) ticks, the last bin takes the rest */
+
+#define RM_TRIGGER_CONDITION_NUM    4
+#ifndef RM_TRIGGER_BUFFER_SIZE
+#ifdef __AVR__
+#define RM_TRIGGER_BUFFER_SIZE      256 /* pre + post trigger samples of the log table */
+#else
+#define RM_TRIGGER_BUFFER_SIZE      4096
+#endif
+#endif
+
+#define RM_AGGREGATE_BIN_NUM        8   /* histogram bins of an entry, the first and last bins also take the values out of range */
+#ifndef RM_AGGREGATE_ENTRY_NUM
+#ifdef __AVR__
+#define RM_AGGREGATE_ENTRY_NUM      4
+#else
+#define RM_AGGREGATE_ENTRY_NUM      12  /* an aggregate frame holds at most 12 entries of 1 byte */
+#endif
+#endif
+
+#ifndef RM_CHANGE_ENTRY_NUM
+#ifdef __AVR__
+#define RM_CHANGE_ENTRY_NUM         8
+#else
+#define RM_CHANGE_ENTRY_NUM         RM_LOG_FACTOR_MAX
+#endif
+#endif
+
+#define RM_SCHEDULE_LENGTH_MAX      256 /* periods until the rates of all entries repeat, the schedule ID is 1 byte */
+
+#ifndef RM_HASH_SLICE_SIZE
+#ifdef __AVR__
+#define RM_HASH_SLICE_SIZE          64  /* bytes hashed per RM_Task(), bounds its duration */
+#else
+#define RM_HASH_SLICE_SIZE          4096
+#endif
+#endif
+#ifndef RM_HASH_CHUNK_NUM
+#ifdef __AVR__
+#define RM_HASH_CHUNK_NUM           8   /* digests of equal parts of the range, for locating a change */
+#else
+#define RM_HASH_CHUNK_NUM           16
+#endif
+#endif
+
+#ifndef RM_SNAPSHOT_BUFFER_SIZE
+#ifdef __AVR__
+#define RM_SNAPSHOT_BUFFER_SIZE     64  /* baseline copy of the range, or 4-byte CRC-32 of each block */
+#else
+#define RM_SNAPSHOT_BUFFER_SIZE     4096
+#endif
+#endif
+
+/* Bytes one compressed dump response reads at most. The scan is a compare per byte, so this is
+   several times a plain dump; a response also ends when its payload is full. At most 0xFFFF. */
+#ifndef RM_COMPRESS_SCAN_SIZE
+#ifdef __AVR__
+#define RM_COMPRESS_SCAN_SIZE       1024
+#else
+#define RM_COMPRESS_SCAN_SIZE       16384
+#endif
+#endif
+
+#define RM_LOG_PROFILE_NAME_SIZE    12  /* names are truncated to this size, without terminator if it is full */
+#ifndef RM_LOG_PROFILE_SLOT_NUM
+#ifdef __AVR__
+#define RM_LOG_PROFILE_SLOT_NUM     1   /* profiles uploaded by the host, each takes a RM_LogInformation of RAM */
+#else
+#define RM_LOG_PROFILE_SLOT_NUM     4
+#endif
+#endif
+
 typedef enum
 {
   RM_STATUS_ERR = 0,
   RM_STATUS_SUCCESS,
-  RM_STATUS_SUCCESS_NR  // no response
+  RM_STATUS_SUCCESS_NR, // no response
+  RM_STATUS_PENDING     // response sent later by RM_CompleteBypass(), bypass functions only
 } RM_Status;
 
 
@@ -45,6 +205,13 @@ typedef struct RM_BYPASS_RESPONSE
     uint16_t length;
 } RM_BypassResponse;
 
+typedef enum
+{
+  RM_BYPASS_STATE_IDLE = 0,
+  RM_BYPASS_STATE_PENDING,      // bypass function returned RM_STATUS_PENDING
+  RM_BYPASS_STATE_COMPLETE      // RM_CompleteBypass() called, response waiting for the transmitter
+} RM_BypassState;
+
 
 typedef enum
 {
@@ -54,6 +221,19 @@ typedef enum
   RM_RECEIVED_STATUS_COMPLETE
 } RM_ReceivedStatus;
 
+typedef enum
+{
+  RM_FRAME_CHECK_CRC8 = 0,  // x^8+x^7+x^4+x^2+1, always used by passkey requests
+  RM_FRAME_CHECK_CRC16,     // CRC-16/XMODEM (0x1021), little-endian
+  RM_FRAME_CHECK_CRC32C     // CRC-32C (Castagnoli), little-endian, hardware accelerated where available
+} RM_FrameCheck;
+
+typedef enum
+{
+  RM_FRAMING_SLIP = 0,      // 0xC0 delimited, 0xC0 and 0xDB escaped
+  RM_FRAMING_COBS           // 0x00 delimited, one code byte per 254 bytes at most
+} RM_Framing;
+
 typedef enum
 {
   RM_TRANSMIT_STATUS_COMPLETE = 0,
@@ -65,6 +245,59 @@ typedef enum
 
 
 typedef RM_BypassResponse (*rm_bypass_function_t)(uint8_t payload[], uint16_t length);
+/* Bypass sub-command, writes up to RM_SND_PAYLOAD_SIZE bytes into response and their number into pLength */
+typedef RM_Status (*rm_command_function_t)(uint8_t request[], uint16_t length, uint8_t response[], uint16_t* pLength);
+typedef bool (*rm_storage_function_t)(uint8_t buffer[], uint16_t size);
+
+struct RM_CONTENTS;
+typedef uint16_t (*rm_response_function_t)(struct RM_CONTENTS* pContents, uint8_t payload[]);
+
+
+typedef enum
+{
+  RM_TYPE_UNSIGNED = 0,
+  RM_TYPE_SIGNED,
+  RM_TYPE_FLOAT,
+  RM_TYPE_BYTES     // arrays, structures and anything else shown as raw bytes
+} RM_VariableType;
+
+/**
+ * @struct RM_RegistryEntry
+ * @brief A monitored variable published to the host, declared with RM_REGISTRY_ENTRY().
+ *
+ * Tables are meant to be const and RM_FLASH, for example:
+ *   const RM_RegistryEntry rmRegistry[] RM_FLASH = { RM_REGISTRY_ENTRY(testCount, RM_TYPE_UNSIGNED) };
+ */
+typedef struct RM_REGISTRYENTRY
+{
+    char name[RM_REGISTRY_NAME_SIZE];
+    const void* address;
+    uint16_t size;
+    uint8_t type;
+} RM_RegistryEntry;
+
+#define RM_REGISTRY_ENTRY(variable, type)   { #variable, (const void*)&(variable), sizeof(variable), (type) }
+
+
+/* Definitions of RM_AccessRegion::access */
+#define RM_ACCESS_READ          0x01
+#define RM_ACCESS_WRITE         0x02
+
+/**
+ * @struct RM_AccessRegion
+ * @brief A memory range the host may read or write, attached by RM_AttachAccessRegions().
+ *
+ * The table must be sorted by start, the regions must not overlap and none may wrap past
+ * RM_ADDRESS_MAX. Like the registry, it is meant to be const and RM_FLASH.
+ */
+typedef struct RM_ACCESSREGION
+{
+    const void* start;
+    rm_address_t size;
+    uint8_t access;
+} RM_AccessRegion;
+
+#define RM_ACCESS_REGION(variable, access)  { (const void*)&(variable), sizeof(variable), (access) }
 
 
 typedef struct RM_RECEIVINGDATA
@@ -73,6 +306,14 @@ typedef struct RM_RECEIVINGDATA
     uint8_t buffer[RM_RCV_FRAME_BUFF_SIZE];
     uint16_t length;
     uint16_t timeoutCnt;
+#ifdef RM_SUPPORT_STATISTICS
+    uint32_t purgedCnt;
+#endif
+#ifdef RM_SUPPORT_COBS
+    uint8_t  framing;           // RM_Framing, kept by RM_ClearReceivedState()
+    uint8_t  cobsCode;          // code byte of the current group
+    uint8_t  cobsRemaining;     // data bytes left in the current group
+#endif
 } RM_ReceivedData;
 
 typedef struct RM_TRANSMITTINGDATA
@@ -81,32 +322,269 @@ typedef struct RM_TRANSMITTINGDATA
     uint8_t  buffer[RM_SND_FRAME_BUFF_SIZE];
     uint16_t  currentIndex;
     uint16_t  maxIndex;
+#ifdef RM_SUPPORT_COBS
+    uint8_t  framing;           // RM_Framing, follows the received frames with each response
+    uint8_t  cobsCode;          // code byte of the current group, 0 while the next code byte is due
+    uint16_t cobsEnd;           // end of the current group in buffer
+#endif
 } RM_TransmittingData;
 
 typedef struct RM_DATA
 {
-#ifdef RM_ADDRESS_4BYTE
-    uint32_t address;
-    uint16_t length;
-#else
-    uint32_t address;
+    rm_address_t address;
     uint16_t length;
-#endif
 } RM_Data;
 
 typedef struct RM_LOGINFORMATION
 {
-#ifdef RM_ADDRESS_4BYTE
-    uint8_t  sizeArray[RM_LOG_FACTOR_MAX];
-    uint32_t addressArray[RM_LOG_FACTOR_MAX];
-#else
     uint8_t  sizeArray[RM_LOG_FACTOR_MAX];
-    uint16_t addressArray[RM_LOG_FACTOR_MAX];
-#endif
+    rm_address_t addressArray[RM_LOG_FACTOR_MAX];
     uint16_t currentIndex;
     uint16_t availableIndex;
 } RM_LogInformation;
 
+/**
+ * @struct RM_Statistics
+ * @brief Link counters, sent as-is (little-endian uint32_t) in response to RM_EXTCODE_STATISTICS.
+ */
+typedef struct RM_STATISTICS
+{
+    uint32_t framesReceived;    // RM frames that passed the frame check, plus RMComm derived frames, which carry no check
+    uint32_t framesSent;        // response, log and RMComm derived frames
+    uint32_t crcErrors;
+    uint32_t rxTimeouts;        // incomplete frames dropped after RM_RCV_TIMEOUT_CNT
+    uint32_t escapePurges;      // frames purged by an invalid escape sequence or overrun
+    uint32_t logSkipped;        // log periods elapsed while the transmitter was busy
+    uint32_t ringOverflows;     // bytes lost by RMComm ring buffers
+    uint32_t bypassCalls;
+    uint32_t accessDenied;      // log entries, dumps and writes outside the attached regions
+} RM_Statistics;
+
+
+typedef enum
+{
+  RM_PROFILE_STAGE_DECODE = 0,  // RM_DecodeReceivedData() batch in RMComm_Run()
+  RM_PROFILE_STAGE_TASK,        // RM_Task()
+  RM_PROFILE_STAGE_GETLOG,      // RM_GatherLogData()
+  RM_PROFILE_STAGE_CRC,         // RM_GetCRC()
+  RM_PROFILE_STAGE_ENCODE,      // RM_EncodeTransmitData() per byte
+  RM_PROFILE_STAGE_NUM
+} RM_ProfileStage;
+
+/**
+ * @struct RM_ProfileRecord
+ * @brief Accumulated durations of a profiled stage in RM_PROFILE_TICK_HZ ticks.
+ *
+ * The mean duration is total / count. The record is sent as-is in response to RM_EXTCODE_PROFILE.
+ */
+typedef struct RM_PROFILERECORD
+{
+    uint64_t total;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t histogram[RM_PROFILE_HISTOGRAM_SIZE];
+} RM_ProfileRecord;
+
+/**
+ * @struct RM_LogProfile
+ * @brief A log table and period compiled into the firmware, attached by RM_AttachLogProfiles().
+ *
+ * Tables are meant to be const and RM_FLASH, for example:
+ *   const RM_LogProfileEntry rmCountEntries[] RM_FLASH = { RM_LOG_PROFILE_ENTRY(testCount) };
+ *   const RM_LogProfile rmProfiles[] RM_FLASH = { RM_LOG_PROFILE("count", 100, rmCountEntries) };
+ */
+typedef struct RM_LOGPROFILEENTRY
+{
+    const void* address;
+    uint8_t size;       // 1, 2, 4 or 8
+} RM_LogProfileEntry;
+
+typedef struct RM_LOGPROFILE
+{
+    char name[RM_LOG_PROFILE_NAME_SIZE];
+    uint16_t logIntervalPeriod;
+    uint16_t count;
+    const RM_LogProfileEntry* entries;
+} RM_LogProfile;
+
+#define RM_LOG_PROFILE_ENTRY(variable)          { (const void*)&(variable), sizeof(variable) }
+#define RM_LOG_PROFILE(name, period, entries)   { name, (period), sizeof(entries) / sizeof((entries)[0]), (entries) }
+
+/**
+ * @struct RM_LogProfileSlot
+ * @brief A log table and period uploaded by the host with RM_EXTCODE_STORE_PROFILE.
+ */
+typedef struct RM_LOGPROFILESLOT
+{
+    char name[RM_LOG_PROFILE_NAME_SIZE];
+    uint16_t logIntervalPeriod;
+    RM_LogInformation log;
+} RM_LogProfileSlot;
+
+typedef enum
+{
+  RM_TRIGGER_ABOVE = 0,     // value > a
+  RM_TRIGGER_BELOW,         // value < a
+  RM_TRIGGER_RISING,        // value crossed a upwards since the previous tick
+  RM_TRIGGER_FALLING,       // value crossed a downwards since the previous tick
+  RM_TRIGGER_INSIDE,        // a <= value <= b
+  RM_TRIGGER_OUTSIDE,       // value < a or value > b
+  RM_TRIGGER_MASK,          // (value & a) == b
+  RM_TRIGGER_TOGGLE,        // a bit of mask a flipped since the previous tick
+  RM_TRIGGER_KIND_NUM
+} RM_TriggerKind;
+
+typedef enum
+{
+  RM_TRIGGER_STATE_IDLE = 0,
+  RM_TRIGGER_STATE_ARMED,       // sampling the pre-trigger window, evaluating the conditions
+  RM_TRIGGER_STATE_TRIGGERED,   // sampling the post-trigger window
+  RM_TRIGGER_STATE_DONE,        // capture ready to be read
+  RM_TRIGGER_STATE_ABORTED      // the log table changed while sampling
+} RM_TriggerState;
+
+/**
+ * @struct RM_TriggerCondition
+ * @brief A condition on a variable, compared as type with the thresholds a and b of the same type.
+ */
+typedef struct RM_TRIGGERCONDITION
+{
+    rm_address_t address;
+    uint32_t a;
+    uint32_t b;
+    uint32_t previous;  // value of the previous tick, for edges and toggles
+    uint8_t  kind;      // RM_TriggerKind
+    uint8_t  type;      // RM_TYPE_UNSIGNED, RM_TYPE_SIGNED or RM_TYPE_FLOAT
+    uint8_t  size;      // 1, 2 or 4, RM_TYPE_FLOAT is 4
+} RM_TriggerCondition;
+
+/**
+ * @struct RM_Trigger
+ * @brief Trigger engine sampling the log table every RM_Task() into a pre/post-trigger ring.
+ *
+ * A sample is the log table as a log frame carries it. The ring keeps preSamples + postSamples
+ * samples; the sample of the tick the conditions are met is the first post-trigger sample.
+ */
+typedef struct RM_TRIGGER
+{
+    RM_TriggerCondition condition[RM_TRIGGER_CONDITION_NUM];
+    uint8_t  conditionCount;
+    bool     isAnyCondition;    // OR of the conditions instead of AND
+    uint8_t  state;             // RM_TriggerState
+    uint16_t sampleSize;
+    uint16_t preSamples;
+    uint16_t postSamples;
+    uint16_t head;              // next slot of the ring
+    uint16_t stored;            // pre-trigger samples kept, at most preSamples
+    uint16_t remaining;         // post-trigger samples still to take
+    uint16_t readIndex;         // first sample of the pending RM_EXTCODE_READ_CAPTURE response
+    uint8_t  buffer[RM_TRIGGER_BUFFER_SIZE];
+} RM_Trigger;
+
+typedef enum
+{
+  RM_LOG_MODE_SAMPLE = 0,   // the values of the log table at the end of each period
+  RM_LOG_MODE_AGGREGATE,    // RM_Aggregate of every tick of each period
+  RM_LOG_MODE_SCHEDULE,     // the entries due in each period, see RM_contents::logDivisor
+  RM_LOG_MODE_CHANGE        // the entries that changed in each tick, and all entries every period
+} RM_LogMode;
+
+/**
+ * @struct RM_Aggregate
+ * @brief Statistics of a log entry over a log period, folded in every RM_Task().
+ *
+ * Values are summed relative to the first sample of the period, so the variance of a large
+ * value with a small spread keeps its precision in float.
+ */
+typedef struct RM_AGGREGATE
+{
+    uint32_t min;           // raw values, compared as type
+    uint32_t max;
+    float    offset;        // first sample of the period
+    float    sum;           // of value - offset
+    float    sumSquares;    // of (value - offset)^2
+    float    binLower;      // lower edge of bin 0
+    float    binScale;      // 1 / bin width
+    uint16_t bin[RM_AGGREGATE_BIN_NUM];
+    uint8_t  type;          // RM_TYPE_UNSIGNED, RM_TYPE_SIGNED or RM_TYPE_FLOAT
+    uint8_t  binCount;      // 0 without histogram
+} RM_Aggregate;
+
+/**
+ * @struct RM_ChangeFilter
+ * @brief Change test of a log entry in RM_LOG_MODE_CHANGE, against the value it was last sent with.
+ */
+typedef struct RM_CHANGEFILTER
+{
+    uint32_t last;          // raw value last sent
+    uint32_t threshold;     // deadband as type, or the bits to watch
+    uint8_t  type;          // RM_TYPE_UNSIGNED, RM_TYPE_SIGNED or RM_TYPE_FLOAT
+    bool     isMask;        // sent when a bit of threshold flips, instead of beyond the deadband
+} RM_ChangeFilter;
+
+typedef enum
+{
+  RM_HASH_STATE_IDLE = 0,
+  RM_HASH_STATE_RUNNING,    // hashing RM_HASH_SLICE_SIZE bytes per RM_Task()
+  RM_HASH_STATE_DONE        // digests ready to be read
+} RM_HashState;
+
+/**
+ * @struct RM_Hash
+ * @brief CRC-32 of a memory range requested by RM_EXTCODE_HASH_REGION, computed across RM_Task() calls.
+ *
+ * The CRC is the one of zlib and Ethernet, so the host can compare it with its own copy of the range.
+ */
+typedef struct RM_HASH
+{
+    rm_address_t address;           // next byte to hash
+    rm_address_t length;
+    rm_address_t remaining;         // bytes of the range still to hash
+    rm_address_t chunkSize;         // 0 without chunk digests
+    rm_address_t chunkRemaining;    // bytes of the current chunk still to hash
+    uint32_t crc;                   // running CRC of the range
+    uint32_t chunkCrc;              // running CRC of the current chunk
+    uint32_t chunk[RM_HASH_CHUNK_NUM];
+    uint8_t  chunkCount;            // chunk digests completed
+    uint8_t  state;                 // RM_HashState
+} RM_Hash;
+
+/**
+ * @struct RM_Snapshot
+ * @brief Baseline of a memory range taken by RM_EXTCODE_SNAPSHOT, for dumps of the changed bytes only.
+ *
+ * Small ranges are copied into buffer and compared byte by byte. Larger ones are split into blocks
+ * of blockSize bytes, and buffer keeps the CRC-32 of each block, so a changed block is sent whole.
+ * The baseline follows what RM_EXTCODE_READ_DIFF sends.
+ */
+typedef struct RM_SNAPSHOT
+{
+    rm_address_t address;
+    uint16_t length;            // 0 without a baseline
+    uint16_t blockSize;         // 0 for a copy of the range
+    uint16_t readOffset;        // first byte of the pending RM_EXTCODE_READ_DIFF response
+    uint8_t  buffer[RM_SNAPSHOT_BUFFER_SIZE];
+} RM_Snapshot;
+
+/**
+ * @struct RM_SessionRecord
+ * @brief Log configuration written and read back by the storage hooks of RM_AttachStorage().
+ *
+ * The record is stored as-is. The addresses of the log table are meaningless after a rebuild, so
+ * buildCrc keys it on the version information and the build ID of RM_AttachBuildId(). Without a
+ * build ID, a rebuild that keeps the version string is not told apart.
+ */
+typedef struct RM_SESSIONRECORD
+{
+    uint32_t token;             // chosen by the host, 0 is never accepted
+    uint16_t logIntervalPeriod;
+    uint16_t availableIndex;
+    uint8_t  sizeArray[RM_LOG_FACTOR_MAX];
+    rm_address_t addressArray[RM_LOG_FACTOR_MAX];
+    uint32_t buildCrc;          // CRC-32 of the version information and the build ID
+    uint8_t  crc;               // RM_GetCRC() of the bytes before this member
+} RM_SessionRecord;
 
 /**
  * @struct RM_contents
@@ -162,6 +640,68 @@ typedef struct RM_LOGINFORMATION
  * 
  * @var RM_contents::bypassFunction
  * Pointer to a function used to bypass standard operations, typically for custom or specialized procedures.
+ * 
+ * @var RM_contents::bypassResponse
+ * Response passed to RM_CompleteBypass(), sent with the sequence code bypassMasCnt of its request.
+ * 
+ * @var RM_contents::command
+ * Sub-command table attached by RM_AttachCommands(), read from RM_FLASH and indexed by the first byte of a
+ * bypass request. Requests beyond commandCount or with a NULL entry go to bypassFunction.
+ * 
+ * @var RM_contents::statistics
+ * Link counters, available when RM_SUPPORT_STATISTICS is defined.
+ * 
+ * @var RM_contents::responseFunction
+ * Function building the payload of the pending response in place of RM_contents::block, cleared once used.
+ * 
+ * @var RM_contents::registry
+ * Variable table attached by RM_AttachRegistry(), read from RM_FLASH.
+ * 
+ * @var RM_contents::accessRegion
+ * Sorted region table attached by RM_AttachAccessRegions(), read from RM_FLASH. Without it any address is accepted.
+ * 
+ * @var RM_contents::saveFunction
+ * Storage hook writing a RM_SessionRecord, attached by RM_AttachStorage().
+ * 
+ * @var RM_contents::loadFunction
+ * Storage hook reading back the RM_SessionRecord, attached by RM_AttachStorage().
+ * 
+ * @var RM_contents::buildId
+ * Identifier of the firmware image attached by RM_AttachBuildId(), folded into RM_SessionRecord::buildCrc.
+ * 
+ * @var RM_contents::logProfile
+ * Compiled-in profiles attached by RM_AttachLogProfiles(), read from RM_FLASH. They are numbered first.
+ * 
+ * @var RM_contents::logProfileSlot
+ * Profiles uploaded by the host, numbered after RM_contents::logProfile. Empty slots have a count of 0.
+ * 
+ * @var RM_contents::trigger
+ * Trigger engine armed by RM_EXTCODE_SET_TRIGGER.
+ * 
+ * @var RM_contents::logMode
+ * RM_LogMode set by RM_EXTCODE_SET_LOG_MODE. Any change of the log table returns to RM_LOG_MODE_SAMPLE.
+ * 
+ * @var RM_contents::aggregate
+ * Statistics of each log entry in RM_LOG_MODE_AGGREGATE, over aggregateCount ticks.
+ * 
+ * @var RM_contents::logDivisor
+ * In RM_LOG_MODE_SCHEDULE, an entry is sent in the periods where logScheduleId is a multiple of its divisor.
+ * logScheduleId counts the periods modulo logScheduleLength, the least common multiple of the divisors.
+ * 
+ * @var RM_contents::changeFilter
+ * Change test of each log entry in RM_LOG_MODE_CHANGE.
+ * 
+ * @var RM_contents::hash
+ * Region hash started by RM_EXTCODE_HASH_REGION.
+ * 
+ * @var RM_contents::snapshot
+ * Baseline of the range compared by RM_EXTCODE_READ_DIFF.
+ * 
+ * @var RM_contents::frameCheck
+ * RM_FrameCheck of the frames after the passkey request that chose it. Until then RM_FRAME_CHECK_CRC8.
+ * 
+ * @var RM_contents::framingTimeoutCnt
+ * Time since the last valid frame, the framing returns to RM_FRAMING_DEFAULT at RM_REQ_TIMEOUT_CNT.
  */
 typedef struct RM_CONTENTS
 {
@@ -188,6 +728,85 @@ typedef struct RM_CONTENTS
 
     rm_bypass_function_t bypassFunction;
 
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+    RM_BypassResponse bypassResponse;
+    uint16_t bypassMasCnt;
+    uint8_t  bypassState;       // RM_BypassState
+#endif
+
+#ifdef RM_SUPPORT_COMMAND_TABLE
+    const rm_command_function_t* command;
+    uint8_t commandCount;
+#endif
+
+#ifdef RM_SUPPORT_STATISTICS
+    RM_Statistics statistics;
+#endif
+
+    rm_response_function_t responseFunction;
+
+#ifdef RM_SUPPORT_REGISTRY
+    const RM_RegistryEntry* registry;
+    uint16_t registryCount;
+    uint16_t registryIndex;
+#endif
+
+#ifdef RM_SUPPORT_ACCESS_CHECK
+    const RM_AccessRegion* accessRegion;
+    uint16_t accessRegionCount;
+#endif
+
+#ifdef RM_SUPPORT_SESSION
+    rm_storage_function_t saveFunction;
+    rm_storage_function_t loadFunction;
+    const uint8_t* buildId;
+    uint16_t buildIdSize;
+#endif
+
+#ifdef RM_SUPPORT_LOG_PROFILE
+    const RM_LogProfile* logProfile;
+    uint16_t logProfileCount;
+    RM_LogProfileSlot logProfileSlot[RM_LOG_PROFILE_SLOT_NUM];
+    uint8_t logProfileIndex;    // first profile of the pending RM_EXTCODE_LIST_PROFILES response
+#endif
+
+#ifdef RM_SUPPORT_TRIGGER
+    RM_Trigger trigger;
+#endif
+
+    uint8_t logMode;
+
+#ifdef RM_SUPPORT_AGGREGATION
+    RM_Aggregate aggregate[RM_AGGREGATE_ENTRY_NUM];
+    uint16_t aggregateCount;
+#endif
+
+#ifdef RM_SUPPORT_SCHEDULE
+    uint8_t  logDivisor[RM_LOG_FACTOR_MAX];
+    uint16_t logScheduleLength;
+    uint8_t  logScheduleId;
+#endif
+
+#ifdef RM_SUPPORT_CHANGE_LOG
+    RM_ChangeFilter changeFilter[RM_CHANGE_ENTRY_NUM];
+#endif
+
+#ifdef RM_SUPPORT_HASH
+    RM_Hash hash;
+#endif
+
+#ifdef RM_SUPPORT_SNAPSHOT
+    RM_Snapshot snapshot;
+#endif
+
+#ifdef RM_SUPPORT_COBS
+    uint16_t framingTimeoutCnt;
+#endif
+
+#ifdef RM_SUPPORT_WIDE_CRC
+    uint8_t frameCheck;
+#endif
+
 } RM_contents;
 
 void RM_Initialize( RM_contents* obj, uint8_t version[], uint16_t versionSize, uint16_t millisCount, uint32_t passkey );
@@ -197,6 +816,43 @@ void RM_DecodeReceivedData(RM_ReceivedData* pReceivingData, uint8_t data);
 bool RM_EncodeTransmitData( RM_TransmittingData* pTransmitData, uint8_t* pData );
 
 void RM_ClearReceivedState(RM_ReceivedData* pReceivingData);
+#ifdef RM_SUPPORT_REGISTRY
+void RM_AttachRegistry( RM_contents* obj, const RM_RegistryEntry table[], uint16_t count );
+#endif
+#ifdef RM_SUPPORT_ACCESS_CHECK
+bool RM_AttachAccessRegions( RM_contents* obj, const RM_AccessRegion table[], uint16_t count );
+#endif
+#ifdef RM_SUPPORT_SESSION
+void RM_AttachStorage( RM_contents* obj, rm_storage_function_t saveFunc, rm_storage_function_t loadFunc );
+void RM_AttachBuildId( RM_contents* obj, const uint8_t id[], uint16_t size );
+#endif
+#ifdef RM_SUPPORT_LOG_PROFILE
+void RM_AttachLogProfiles( RM_contents* obj, const RM_LogProfile table[], uint16_t count );
+bool RM_SelectLogProfile( RM_contents* obj, uint8_t index );
+#endif
+#ifdef RM_SUPPORT_ASYNC_BYPASS
+bool RM_CompleteBypass( RM_contents* obj, RM_BypassResponse response );
+#endif
+#ifdef RM_SUPPORT_COMMAND_TABLE
+void RM_AttachCommands( RM_contents* obj, const rm_command_function_t table[], uint8_t count );
+#endif
+bool RM_IsAccessible( RM_contents* obj, rm_address_t address, rm_address_t length, uint8_t access );
+uint16_t RM_GatherLogData( RM_LogInformation* pLogInformation, uint8_t buffer[] );
+
+#ifdef RM_SUPPORT_PROFILING
+void RM_InitializeProfile( void );
+void RM_RecordProfile( RM_ProfileStage stage, uint32_t ticks );
+bool RM_GetProfile( RM_ProfileStage stage, RM_ProfileRecord* pRecord );
+#ifdef __linux__
+uint32_t RM_GetProfileTick( void );
+#endif
+
+#define RM_PROFILE_BEGIN(start)         rm_profile_tick_t start = RM_PROFILE_GET_TICK()
+#define RM_PROFILE_END(stage, start)    RM_RecordProfile((stage), (rm_profile_tick_t)(RM_PROFILE_GET_TICK() - (start)))
+#else
+#define RM_PROFILE_BEGIN(start)
+#define RM_PROFILE_END(stage, start)
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,1126 @@
+#ifndef RM_CORE_HPP
+#define RM_CORE_HPP
+
+//******************************************************************************
+// RmCore(C++17 header-only variant)
+// Copyright 2024 Naoya Imai
+//******************************************************************************
+
+/*
+ * rm::RmCore<AddrT, LogMax, RxSize, TxSize, Features...> speaks the same protocol as
+ * RmCore.c + RmComm.c, with everything that RmCore.h selects by #ifdef given as
+ * template arguments instead:
+ *
+ *   AddrT      rm_address_t equivalent, uint16_t / uint32_t / uint64_t
+ *   LogMax     RM_LOG_FACTOR_MAX equivalent, entries of the log table
+ *   RxSize     RM_RCV_FRAME_BUFF_SIZE equivalent, received frame size
+ *   TxSize     RM_SND_PAYLOAD_SIZE equivalent, payload of responses and log frames
+ *   Features   any of rm::Value64, rm::Bypass, rm::Statistics, rm::SerialEmulation<In, Out>
+ *
+ * The CRC and SetLogData/WriteValue parser tables are generated at compile time for the
+ * chosen address width (in flash on AVR), and the code of features not listed is not
+ * compiled at all. The C API stays the reference; access regions and the extended requests
+ * other than statistics are only provided by RmCore.c.
+ *
+ * Example for ArduinoUnoR3, equivalent to rmDemo.ino without bypass and 64-bit values:
+ *   rm::RmCore<uint16_t, 32, 32, 128, rm::SerialEmulation<32, 128>> rmCore;
+ *   rmCore.initialize((const uint8_t*)version, sizeof(version), 10, 0x0000FFFFU);
+ *   ... rmCore.setReceivedData(Serial.read()); rmCore.run(); rmCore.tryTransmission(&data); ...
+ *
+ * No standard library header is used, so it also builds with avr-g++ -std=gnu++17.
+ */
+
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#define RM_CPP_FLASH                    PROGMEM
+#define RM_CPP_READ_BYTE(address)       pgm_read_byte(address)
+#else
+#define RM_CPP_FLASH
+#define RM_CPP_READ_BYTE(address)       (*(address))
+#endif
+
+namespace rm
+{
+
+/*-- begin: features --*/
+
+struct Value64 {};      // 8-byte values in log tables and WriteValue requests
+struct Bypass {};       // opcode 0x08, see RmCore::attachBypassFunction()
+struct Statistics {};   // link counters, extended request 0x01
+
+/* Serial emulation over derived frames (RMComm_Read/RMComm_Write), ring sizes must be 2^n */
+template <uint16_t In, uint16_t Out>
+struct SerialEmulation {};
+
+/*-- begin: definitions --*/
+
+enum Status : uint8_t
+{
+    STATUS_ERR = 0,
+    STATUS_SUCCESS,
+    STATUS_SUCCESS_NR   // no response
+};
+
+struct BypassResponse
+{
+    Status status;
+    uint8_t* buffer;
+    uint16_t length;
+};
+
+typedef BypassResponse (*bypass_function_t)(uint8_t payload[], uint16_t length);
+
+/* Same layout as RM_Statistics, so hosts parse both the same way */
+struct LinkStatistics
+{
+    uint32_t framesReceived;
+    uint32_t framesSent;
+    uint32_t crcErrors;
+    uint32_t rxTimeouts;
+    uint32_t escapePurges;
+    uint32_t logSkipped;
+    uint32_t ringOverflows;
+    uint32_t bypassCalls;
+    uint32_t accessDenied;      // always 0, access regions are not supported here
+};
+
+namespace detail
+{
+
+struct Empty {};
+
+template <typename A, typename B> struct IsSame { static constexpr bool value = false; };
+template <typename A> struct IsSame<A, A> { static constexpr bool value = true; };
+
+template <bool Condition, typename T, typename F> struct Select { typedef T type; };
+template <typename T, typename F> struct Select<false, T, F> { typedef F type; };
+
+template <typename F>
+struct EmulationTraits
+{
+    static constexpr bool enabled = false;
+    static constexpr uint16_t inSize = 1;
+    static constexpr uint16_t outSize = 1;
+};
+
+template <uint16_t In, uint16_t Out>
+struct EmulationTraits<SerialEmulation<In, Out>>
+{
+    static constexpr bool enabled = true;
+    static constexpr uint16_t inSize = In;
+    static constexpr uint16_t outSize = Out;
+};
+
+template <typename... Fs>
+struct FindEmulation { typedef EmulationTraits<void> type; };
+
+template <typename F, typename... Rest>
+struct FindEmulation<F, Rest...>
+{
+    typedef typename Select<EmulationTraits<F>::enabled, EmulationTraits<F>, typename FindEmulation<Rest...>::type>::type type;
+};
+
+template <uint16_t N>
+struct Table
+{
+    uint8_t value[N];
+};
+
+/* x^8+x^7+x^4+x^2+1, the same polynomial as RM_CrcTable */
+constexpr Table<256> makeCrcTable()
+{
+    Table<256> table = {};
+
+    for( uint16_t index = 0; index < 256; index++ )
+    {
+        uint8_t crc = (uint8_t)index;
+        for( uint8_t bit = 0; bit < 8; bit++ )
+        {
+            crc = ((crc & 0x80) != 0) ? (uint8_t)((crc << 1) ^ 0xD5) : (uint8_t)(crc << 1);
+        }
+        table.value[index] = crc;
+    }
+
+    return table;
+}
+
+/* payload size of a SetLogData frame -> number of entries, 0 if it is not code + n * (size + address) up to Max */
+template <uint16_t Size, uint16_t Unit, uint8_t Max>
+constexpr Table<Size> makeLogParser()
+{
+    Table<Size> table = {};
+
+    for( uint16_t index = 1 + Unit; index < Size; index++ )
+    {
+        uint16_t count = (index - 1) / Unit;
+        table.value[index] = ((((index - 1) % Unit) == 0) && (count <= Max)) ? (uint8_t)count : 0;
+    }
+
+    return table;
+}
+
+/* payload size of a WriteValue frame -> size of the value, 0 if invalid */
+template <uint16_t Size, uint16_t AddressSize, bool IsValue64>
+constexpr Table<Size> makeWriteParser()
+{
+    Table<Size> table = {};
+
+    table.value[1 + AddressSize + 1] = 1;
+    table.value[1 + AddressSize + 2] = 2;
+    table.value[1 + AddressSize + 4] = 4;
+    if( IsValue64 )
+    {
+        table.value[1 + AddressSize + 8] = 8;
+    }
+
+    return table;
+}
+
+inline constexpr Table<256> crcTable RM_CPP_FLASH = makeCrcTable();
+
+template <uint16_t Size>
+struct Ring
+{
+    static_assert(Size >= 1 && (Size & (Size - 1)) == 0, "ring size should be 2^n");
+
+    uint8_t buffer[Size];
+    uint16_t head;
+    uint16_t tail;
+    uint32_t overflowCnt;
+
+    void clear() { head = 0; tail = 0; overflowCnt = 0; }
+    uint16_t available() const { return (uint16_t)((head - tail) & (Size - 1)); }
+
+    bool enqueue( uint8_t data )
+    {
+        uint16_t next = (uint16_t)((head + 1) & (Size - 1));
+        if( next == tail )
+        {
+            overflowCnt++;
+            return false;
+        }
+        buffer[head] = data;
+        head = next;
+        return true;
+    }
+
+    bool dequeue( uint8_t* pData )
+    {
+        if( head == tail )
+        {
+            return false;
+        }
+        *pData = buffer[tail];
+        tail = (uint16_t)((tail + 1) & (Size - 1));
+        return true;
+    }
+};
+
+} // namespace detail
+
+/*-- begin: core --*/
+
+template <typename AddrT, uint8_t LogMax, uint16_t RxSize, uint16_t TxSize, typename... Features>
+class RmCore
+{
+public:
+    static constexpr bool hasValue64 = (detail::IsSame<Value64, Features>::value || ...);
+    static constexpr bool hasBypass = (detail::IsSame<Bypass, Features>::value || ...);
+    static constexpr bool hasStatistics = (detail::IsSame<Statistics, Features>::value || ...);
+    typedef typename detail::FindEmulation<Features...>::type Emulation;
+    static constexpr bool hasEmulation = Emulation::enabled;
+
+    static constexpr uint16_t ADDRESS_SIZE = sizeof(AddrT);
+    static constexpr uint16_t RX_RING_SIZE = 16;        /* RMCOMM_RXBUFFER_SIZE */
+
+    static_assert(ADDRESS_SIZE == 2 || ADDRESS_SIZE == 4 || ADDRESS_SIZE == 8, "AddrT should be uint16_t, uint32_t or uint64_t");
+    static_assert(ADDRESS_SIZE >= sizeof(void*), "AddrT should hold a pointer of this target");
+    static_assert(LogMax >= 1, "LogMax should be 1 or more");
+    static_assert(RxSize >= (1 + 1 + ADDRESS_SIZE + 1 + 1) && RxSize <= 1024, "RxSize should be from a dump request to 1024");
+    static_assert(TxSize >= 8 && TxSize <= 252, "TxSize should be 8 to 252");
+
+    void initialize( const uint8_t version[], uint16_t versionSize, uint16_t millisCount, uint32_t passkey )
+    {
+        versionAddress_ = (AddrT)(uintptr_t)version;
+        versionLength_ = versionSize;
+        millisCnt_ = millisCount;
+        passKey_ = passkey;
+
+        logTimeoutCnt_ = 0;
+        logIntervalCnt_ = 0;
+        logIntervalPeriod_ = SND_DEFAULT_CNT;
+        isLogging_ = false;
+        isApproved_ = false;
+        isRequestFinished_ = true;
+        masCnt_ = 0x00;
+        slvCnt_ = 0x01;     // initial slv_cnt is "0xX1"
+
+        blockAddress_ = 0;
+        blockLength_ = 0;
+        logCurrentIndex_ = 0;
+        logAvailableIndex_ = 0;
+
+        clearReceivedState();
+        txStatus_ = TX_COMPLETE;
+        txCurrentIndex_ = 0;
+        txMaxIndex_ = 0;
+
+        rxRing_.clear();
+        if constexpr (hasEmulation)
+        {
+            emulationIn_.clear();
+            emulationOut_.clear();
+        }
+        if constexpr (hasBypass)
+        {
+            bypassFunction_ = (bypass_function_t)0;
+        }
+        if constexpr (hasStatistics)
+        {
+            statistics_ = LinkStatistics();
+        }
+    }
+
+    /* RMComm_Run() equivalent, to be called every millisCount */
+    void run( void )
+    {
+        uint8_t data;
+
+        while( rxStatus_ != RX_COMPLETE && rxRing_.dequeue(&data) )
+        {
+            decodeReceivedData(data);
+        }
+
+        if( rxStatus_ == RX_COMPLETE && rxBuffer_[DERIVED_IDENTIFICATION_IDX] == DERIVED_FRAME )
+        {
+            countStatistics(&LinkStatistics::framesReceived);
+            if constexpr (hasEmulation)
+            {
+                if( rxBuffer_[DERIVED_MODE_IDX] == DERIVED_MODE_SERIALCOMM_EMULATION )
+                {
+                    for( uint16_t index = DERIVED_PAYLOAD_IDX; index < rxLength_; index++ )
+                    {
+                        emulationIn_.enqueue(rxBuffer_[index]);
+                    }
+                }
+            }
+            clearReceivedState();
+        }
+
+        if constexpr (hasStatistics)
+        {
+            statistics_.ringOverflows = rxRing_.overflowCnt;
+            if constexpr (hasEmulation)
+            {
+                statistics_.ringOverflows += emulationIn_.overflowCnt + emulationOut_.overflowCnt;
+            }
+        }
+
+        task();
+
+        if constexpr (hasEmulation)
+        {
+            uint16_t size = emulationOut_.available();
+            if( isLogging_ && txStatus_ == TX_COMPLETE && size > 0 )
+            {
+                txBuffer_[DERIVED_IDENTIFICATION_IDX] = DERIVED_FRAME;
+                txBuffer_[DERIVED_MODE_IDX] = DERIVED_MODE_SERIALCOMM_EMULATION;
+                if( size > TxSize )
+                {
+                    size = TxSize;
+                }
+                for( uint16_t index = 0; index < size; index++ )
+                {
+                    emulationOut_.dequeue(&txBuffer_[DERIVED_PAYLOAD_IDX + index]);
+                }
+                txCurrentIndex_ = 0;
+                txMaxIndex_ = DERIVED_HEADER_SIZE + size;
+                txStatus_ = TX_READY;
+                countStatistics(&LinkStatistics::framesSent);
+            }
+        }
+    }
+
+    bool tryTransmission( uint8_t* pData )
+    {
+        return (txStatus_ == TX_READY) ? getTransmitData(pData) : false;
+    }
+
+    bool getTransmitData( uint8_t* pData )
+    {
+        uint8_t data = 0x00;
+
+        if( txStatus_ == TX_COMPLETE )
+        {
+            return false;
+        }
+
+        if( txStatus_ == TX_READY )
+        {
+            txStatus_ = TX_BUSY;
+            txCurrentIndex_ = 0;
+            data = FRAME_CHAR_END;
+        }
+        else if( txStatus_ == TX_BUSY )
+        {
+            if( txCurrentIndex_ < txMaxIndex_ )
+            {
+                data = txBuffer_[txCurrentIndex_];
+                if( data == FRAME_CHAR_END )
+                {
+                    data = FRAME_CHAR_ESC;
+                    txBuffer_[txCurrentIndex_] = FRAME_CHAR_ESC_END;
+                }
+                else if( data == FRAME_CHAR_ESC )
+                {
+                    txBuffer_[txCurrentIndex_] = FRAME_CHAR_ESC_ESC;
+                }
+                else
+                {
+                    txCurrentIndex_++;
+                }
+            }
+            else
+            {
+                txStatus_ = TX_CLOSING;
+                data = FRAME_CHAR_END;
+            }
+        }
+        else
+        {
+            txStatus_ = TX_COMPLETE;
+            return false;
+        }
+
+        *pData = data;
+        return true;
+    }
+
+    void setReceivedData( uint8_t data ) { rxRing_.enqueue(data); }
+
+    bool isConnected( void ) const { return isLogging_; }
+
+    bool isIdle( void ) const
+    {
+        return !isLogging_ && isRequestFinished_ && rxStatus_ == RX_READY &&
+               txStatus_ == TX_COMPLETE && rxRing_.available() == 0;
+    }
+
+    void attachBypassFunction( bypass_function_t func )
+    {
+        static_assert(hasBypass, "attachBypassFunction() requires rm::Bypass");
+        if constexpr (hasBypass)
+        {
+            bypassFunction_ = func;
+        }
+    }
+
+    const LinkStatistics& getStatistics( void ) const
+    {
+        static_assert(hasStatistics, "getStatistics() requires rm::Statistics");
+        return statistics_;
+    }
+
+    /*-- serial emulation, RMComm_Write/Read/Available equivalents --*/
+
+    void write( uint8_t data )
+    {
+        static_assert(hasEmulation, "write() requires rm::SerialEmulation");
+        if constexpr (hasEmulation)
+        {
+            if( isLogging_ )
+            {
+                emulationOut_.enqueue(data);
+            }
+        }
+    }
+
+    uint8_t read( void )
+    {
+        static_assert(hasEmulation, "read() requires rm::SerialEmulation");
+        uint8_t data = 0;
+        if constexpr (hasEmulation)
+        {
+            emulationIn_.dequeue(&data);
+        }
+        return data;
+    }
+
+    uint16_t available( void )
+    {
+        static_assert(hasEmulation, "available() requires rm::SerialEmulation");
+        if constexpr (hasEmulation)
+        {
+            return emulationIn_.available();
+        }
+        return 0;
+    }
+
+private:
+    enum RxStatus : uint8_t { RX_READY = 0, RX_BUSY_NORMAL, RX_BUSY_ESCAPE, RX_COMPLETE };
+    enum TxStatus : uint8_t { TX_COMPLETE = 0, TX_READY, TX_BUSY, TX_CLOSING };
+
+    static constexpr uint16_t RCV_TIMEOUT_CNT = 100;    // ms
+    static constexpr uint16_t REQ_TIMEOUT_CNT = 2000;   // ms
+    static constexpr uint16_t SND_DEFAULT_CNT = 500;    // ms
+
+    static constexpr uint8_t FRAME_CHAR_END = 0xC0;
+    static constexpr uint8_t FRAME_CHAR_ESC = 0xDB;
+    static constexpr uint8_t FRAME_CHAR_ESC_END = 0xDC;
+    static constexpr uint8_t FRAME_CHAR_ESC_ESC = 0xDD;
+
+    static constexpr uint8_t FRAME_SEQCODE = 0;
+    static constexpr uint8_t FRAME_PAYLOAD = 1;
+
+    static constexpr uint8_t SETLOG_BIT_MASK = 0xF0;
+    static constexpr uint8_t SETLOG_START_BIT = 0x10;
+    static constexpr uint8_t SETLOG_END_BIT = 0x20;
+
+    static constexpr uint8_t OPCODE_EXTENDED = 0x09;
+    static constexpr uint8_t EXTCODE_STATISTICS = 0x01;
+
+    static constexpr uint8_t DERIVED_IDENTIFICATION_IDX = 0;
+    static constexpr uint8_t DERIVED_FRAME = 0x00;
+    static constexpr uint8_t DERIVED_MODE_IDX = 1;
+    static constexpr uint8_t DERIVED_MODE_SERIALCOMM_EMULATION = 0x01;
+    static constexpr uint8_t DERIVED_PAYLOAD_IDX = 2;
+    static constexpr uint8_t DERIVED_HEADER_SIZE = 2;
+
+    /* Parser tables, indexed by the payload size of a received frame */
+    static constexpr uint16_t LOG_UNIT = 1 + ADDRESS_SIZE;
+    static constexpr uint16_t LOG_PARSER_SIZE = 1 + ((RxSize - 3) / LOG_UNIT) * LOG_UNIT + 1;
+    static constexpr uint16_t WRITE_PARSER_SIZE = 1 + ADDRESS_SIZE + 8 + 1;
+
+    static constexpr detail::Table<LOG_PARSER_SIZE> logParser RM_CPP_FLASH = detail::makeLogParser<LOG_PARSER_SIZE, LOG_UNIT, LogMax>();
+    static constexpr detail::Table<WRITE_PARSER_SIZE> writeParser RM_CPP_FLASH = detail::makeWriteParser<WRITE_PARSER_SIZE, ADDRESS_SIZE, hasValue64>();
+
+    /* A log frame carries RM_FRAME_PAYLOAD + data bytes before the CRC, see RM_GetLogData() */
+    static constexpr uint16_t TX_BUFFER_SIZE = FRAME_PAYLOAD + TxSize + FRAME_PAYLOAD + 1;
+
+    template <typename Counter>
+    void countStatistics( Counter counter )
+    {
+        if constexpr (hasStatistics)
+        {
+            (statistics_.*counter)++;
+        }
+        (void)counter;
+    }
+
+    void clearReceivedState( void )
+    {
+        rxStatus_ = RX_READY;
+        rxLength_ = 0;
+        rxTimeoutCnt_ = 0;
+    }
+
+    void decodeReceivedData( uint8_t data )
+    {
+        rxTimeoutCnt_ = 0;  // RCV_TIMEOUT_CNT limits the gap between bytes
+
+        /* A full buffer can still take the closing FRAME_CHAR_END */
+        if( rxLength_ >= RxSize && data != FRAME_CHAR_END )
+        {
+            countStatistics(&LinkStatistics::escapePurges);
+            rxStatus_ = RX_READY;
+            rxLength_ = 0;
+        }
+
+        if( rxStatus_ == RX_READY )
+        {
+            if( data == FRAME_CHAR_END )
+            {
+                rxStatus_ = RX_BUSY_NORMAL;
+            }
+        }
+        else if( rxStatus_ == RX_BUSY_NORMAL )
+        {
+            if( data == FRAME_CHAR_ESC )
+            {
+                rxStatus_ = RX_BUSY_ESCAPE;
+            }
+            else if( data == FRAME_CHAR_END )
+            {
+                /* RM_FRAME_CHAR_END,RM_FRAME_CHAR_END: the last one might be Start of Frame */
+                if( rxLength_ != 0 )
+                {
+                    rxStatus_ = RX_COMPLETE;
+                }
+            }
+            else
+            {
+                rxBuffer_[rxLength_++] = data;
+            }
+        }
+        else if( rxStatus_ == RX_BUSY_ESCAPE )
+        {
+            rxStatus_ = RX_BUSY_NORMAL;
+            if( data == FRAME_CHAR_ESC_END )
+            {
+                rxBuffer_[rxLength_++] = FRAME_CHAR_END;
+            }
+            else if( data == FRAME_CHAR_ESC_ESC )
+            {
+                rxBuffer_[rxLength_++] = FRAME_CHAR_ESC;
+            }
+            else
+            {
+                countStatistics(&LinkStatistics::escapePurges);
+                rxStatus_ = RX_READY;
+                rxLength_ = 0;
+            }
+        }
+    }
+
+    static uint8_t getCrc( const uint8_t buffer[], uint16_t size )
+    {
+        uint8_t crc = 0;
+
+        for( uint16_t index = 0; index < size; index++ )
+        {
+            crc = RM_CPP_READ_BYTE(&detail::crcTable.value[crc ^ buffer[index]]);
+        }
+
+        return crc;
+    }
+
+    static AddrT getAddress( const uint8_t buffer[] )
+    {
+        AddrT address = 0;
+
+        for( uint16_t index = ADDRESS_SIZE; index > 0; index-- )
+        {
+            address = (AddrT)((address << 8) | buffer[index - 1]);
+        }
+
+        return address;
+    }
+
+    static bool isValidSize( uint8_t size )
+    {
+        return size == 1 || size == 2 || size == 4 || (hasValue64 && size == 8);
+    }
+
+    void task( void )
+    {
+        if( rxStatus_ == RX_BUSY_NORMAL || rxStatus_ == RX_BUSY_ESCAPE )
+        {
+            rxTimeoutCnt_ += millisCnt_;
+            if( rxTimeoutCnt_ >= RCV_TIMEOUT_CNT )
+            {
+                countStatistics(&LinkStatistics::rxTimeouts);
+                clearReceivedState();
+            }
+        }
+        else if( rxStatus_ == RX_COMPLETE && isRequestFinished_ )
+        {
+            if( getCrc(rxBuffer_, rxLength_) == 0 )
+            {
+                uint8_t opcode = rxBuffer_[FRAME_SEQCODE] & 0x0F;
+                uint8_t master_count = rxBuffer_[FRAME_SEQCODE] & 0xF0;
+                Status result;
+
+                countStatistics(&LinkStatistics::framesReceived);
+                rxLength_--;    // delete crc data size
+
+                result = analyzeReceivedFrame(opcode);
+                if( result != STATUS_ERR )
+                {
+                    masCnt_ = master_count;
+                    logTimeoutCnt_ = 0;
+                }
+
+                if( result == STATUS_SUCCESS )
+                {
+                    isRequestFinished_ = setTransmitBlockData();
+                }
+            }
+            else
+            {
+                countStatistics(&LinkStatistics::crcErrors);
+            }
+
+            clearReceivedState();
+        }
+
+        if( !isRequestFinished_ )
+        {
+            isRequestFinished_ = setTransmitBlockData();
+        }
+
+        if( isLogging_ )
+        {
+            logTimeoutCnt_ += millisCnt_;
+            if( logTimeoutCnt_ >= REQ_TIMEOUT_CNT )
+            {
+                logTimeoutCnt_ = 0;
+                isLogging_ = false;
+            }
+
+            logIntervalCnt_ += millisCnt_;
+            if( logIntervalCnt_ >= logIntervalPeriod_ )
+            {
+                logIntervalCnt_ = 0;
+                if( isRequestFinished_ )
+                {
+                    setTransmitLogData();
+                }
+                else
+                {
+                    countStatistics(&LinkStatistics::logSkipped);
+                }
+            }
+        }
+    }
+
+    void nextSlaveCount( void )
+    {
+        slvCnt_++;
+        if( slvCnt_ > 0x0F )
+        {
+            slvCnt_ = 0x01;
+        }
+    }
+
+    void closeFrame( uint16_t dataSize )
+    {
+        uint16_t frame_size = 1 + dataSize;
+
+        txBuffer_[FRAME_SEQCODE] = (uint8_t)(masCnt_ + slvCnt_);
+        txBuffer_[frame_size] = getCrc(txBuffer_, frame_size);
+        frame_size++;
+
+        txCurrentIndex_ = 0;
+        txMaxIndex_ = frame_size;
+        txStatus_ = TX_READY;
+        countStatistics(&LinkStatistics::framesSent);
+    }
+
+    bool setTransmitBlockData( void )
+    {
+        const uint8_t* source = (const uint8_t*)(uintptr_t)blockAddress_;
+
+        if( txStatus_ != TX_COMPLETE )
+        {
+            return false;
+        }
+
+        nextSlaveCount();
+        for( uint16_t index = 0; index < blockLength_; index++ )
+        {
+            txBuffer_[FRAME_PAYLOAD + index] = source[index];
+        }
+        closeFrame(blockLength_);
+
+        return true;
+    }
+
+    bool setTransmitLogData( void )
+    {
+        nextSlaveCount();
+
+        if( txStatus_ != TX_COMPLETE )
+        {
+            countStatistics(&LinkStatistics::logSkipped);
+            return false;
+        }
+
+        if( logAvailableIndex_ == 0 )
+        {
+            return false;
+        }
+
+        /* The size counts RM_FRAME_PAYLOAD as well, RM Classic expects log frames of this length */
+        closeFrame(FRAME_PAYLOAD + gatherLogData(&txBuffer_[FRAME_PAYLOAD]));
+        return true;
+    }
+
+    uint16_t gatherLogData( uint8_t buffer[] ) const
+    {
+        uint16_t payload_index = 0;
+
+        for( uint8_t index = 0; index < logAvailableIndex_; index++ )
+        {
+            const void* address = (const void*)(uintptr_t)logAddress_[index];
+
+            switch( logSize_[index] )
+            {
+            case 1:
+                buffer[payload_index++] = *(const uint8_t*)address;
+                break;
+
+            case 2:
+                payload_index = putValue(buffer, payload_index, *(const uint16_t*)address, 2);
+                break;
+
+            case 4:
+                payload_index = putValue(buffer, payload_index, *(const uint32_t*)address, 4);
+                break;
+
+            case 8:
+                if constexpr (hasValue64)
+                {
+                    payload_index = putValue(buffer, payload_index, *(const uint64_t*)address, 8);
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        return payload_index;
+    }
+
+    template <typename T>
+    static uint16_t putValue( uint8_t buffer[], uint16_t index, T value, uint8_t size )
+    {
+        for( uint8_t count = 0; count < size; count++ )
+        {
+            buffer[index++] = (uint8_t)value;
+            value = (T)(value >> 8);
+        }
+        return index;
+    }
+
+    template <typename T>
+    T getValue( uint16_t index, uint8_t size ) const
+    {
+        T value = 0;
+        for( uint8_t count = size; count > 0; count-- )
+        {
+            value = (T)((value << 8) | rxBuffer_[index + count - 1]);
+        }
+        return value;
+    }
+
+    void clearBlock( void )
+    {
+        blockAddress_ = 0;
+        blockLength_ = 0;
+    }
+
+    Status analyzeReceivedFrame( uint8_t opcode )
+    {
+        if( !isApproved_ )
+        {
+            /* Try connecting */
+            return (opcode == 0x06) ? validatePassKey() : STATUS_ERR;
+        }
+
+        switch( opcode )
+        {
+        case 0x01:  return setLogStart();
+        case 0x02:  return setLogStop();
+        case 0x03:  return setLogPeriod();
+        case 0x04:  return writeValue();
+        case 0x05:  return setLogData();
+        case 0x06:  return validatePassKey();
+        case 0x07:  return setDumpData();
+        case 0x08:
+            if constexpr (hasBypass)
+            {
+                return setBypassFunction();
+            }
+            return STATUS_ERR;
+        case OPCODE_EXTENDED:
+            if constexpr (hasStatistics)
+            {
+                return readStatistics();
+            }
+            return STATUS_ERR;
+        default:    return STATUS_ERR;
+        }
+    }
+
+    Status setLogStart( void )
+    {
+        if( rxLength_ != (1 + 0) )
+        {
+            return STATUS_ERR;
+        }
+
+        clearBlock();
+        if( isLogging_ )
+        {
+            return STATUS_SUCCESS_NR;
+        }
+
+        isLogging_ = true;
+        return STATUS_SUCCESS;
+    }
+
+    Status setLogStop( void )
+    {
+        if( rxLength_ != (1 + 0) )
+        {
+            return STATUS_ERR;
+        }
+
+        clearBlock();
+        isLogging_ = false;
+        return STATUS_SUCCESS;
+    }
+
+    Status setLogPeriod( void )
+    {
+        uint16_t period;
+
+        if( rxLength_ != (1 + 2) )
+        {
+            return STATUS_ERR;
+        }
+
+        period = getValue<uint16_t>(FRAME_PAYLOAD, 2);
+        if( period == 0 )
+        {
+            return STATUS_ERR;
+        }
+
+        logIntervalPeriod_ = period;
+        clearBlock();
+        isLogging_ = false;
+        return STATUS_SUCCESS;
+    }
+
+    Status writeValue( void )
+    {
+        uint16_t available_size = rxLength_ - 1;
+        uint16_t value_index = FRAME_PAYLOAD + 1 + ADDRESS_SIZE;
+        uint8_t size;
+        void* address;
+
+        if( available_size == 0 || available_size >= WRITE_PARSER_SIZE )
+        {
+            return STATUS_ERR;
+        }
+
+        size = rxBuffer_[FRAME_PAYLOAD + 0];
+        if( size == 0 || size != RM_CPP_READ_BYTE(&writeParser.value[available_size]) )
+        {
+            return STATUS_ERR;
+        }
+
+        address = (void*)(uintptr_t)getAddress(&rxBuffer_[FRAME_PAYLOAD + 1]);
+        switch( size )
+        {
+        case 1:
+            *(uint8_t*)address = rxBuffer_[value_index];
+            break;
+
+        case 2:
+            *(uint16_t*)address = getValue<uint16_t>(value_index, 2);
+            break;
+
+        case 4:
+            *(uint32_t*)address = getValue<uint32_t>(value_index, 4);
+            break;
+
+        case 8:
+            if constexpr (hasValue64)
+            {
+                *(uint64_t*)address = getValue<uint64_t>(value_index, 8);
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        clearBlock();
+        return isLogging_ ? STATUS_SUCCESS_NR : STATUS_SUCCESS;
+    }
+
+    Status setLogData( void )
+    {
+        uint16_t available_size = rxLength_ - 1;
+        uint16_t total_size;
+        uint8_t max_index;
+        uint8_t bitmap;
+        uint8_t size;
+
+        if( available_size == 0 || available_size >= LOG_PARSER_SIZE )
+        {
+            return failSetLogData();
+        }
+
+        max_index = RM_CPP_READ_BYTE(&logParser.value[available_size]);
+        if( max_index == 0 )
+        {
+            return failSetLogData();
+        }
+
+        /* Detect Start of SetLogDataFrame */
+        bitmap = rxBuffer_[FRAME_PAYLOAD + 0] & SETLOG_BIT_MASK;
+        if( (bitmap & SETLOG_START_BIT) != 0 )
+        {
+            logCurrentIndex_ = 0;
+        }
+
+        if( (logCurrentIndex_ + max_index) > LogMax )
+        {
+            return failSetLogData();
+        }
+
+        for( uint8_t index = 0; index < max_index; index++ )
+        {
+            uint16_t base_index = FRAME_PAYLOAD + 1 + index * LOG_UNIT;
+
+            size = rxBuffer_[base_index];
+            if( !isValidSize(size) )
+            {
+                return failSetLogData();
+            }
+
+            logSize_[logCurrentIndex_] = size;
+            logAddress_[logCurrentIndex_] = getAddress(&rxBuffer_[base_index + 1]);
+            logCurrentIndex_++;
+        }
+
+        /* Detect End of SetLogDataFrame */
+        if( (bitmap & SETLOG_END_BIT) != 0 )
+        {
+            logAvailableIndex_ = logCurrentIndex_;
+        }
+
+        total_size = 0;
+        for( uint8_t index = 0; index < logCurrentIndex_; index++ )
+        {
+            total_size += logSize_[index];
+        }
+
+        if( total_size > TxSize )
+        {
+            return failSetLogData();
+        }
+
+        clearBlock();
+        isLogging_ = false;
+        return STATUS_SUCCESS;
+    }
+
+    Status failSetLogData( void )
+    {
+        logCurrentIndex_ = 0;
+        logAvailableIndex_ = 0;
+        clearBlock();
+        isLogging_ = false;
+        return STATUS_ERR;
+    }
+
+    Status validatePassKey( void )
+    {
+        if( rxLength_ != (1 + 4) || getValue<uint32_t>(FRAME_PAYLOAD, 4) != passKey_ )
+        {
+            isApproved_ = false;
+            return STATUS_ERR;
+        }
+
+        isApproved_ = true;
+        blockAddress_ = versionAddress_;
+        blockLength_ = (versionLength_ > TxSize) ? TxSize : versionLength_;
+        isLogging_ = false;
+        return STATUS_SUCCESS;
+    }
+
+    Status setDumpData( void )
+    {
+        uint8_t length;
+
+        if( rxLength_ != (1 + ADDRESS_SIZE + 1) )
+        {
+            return STATUS_ERR;
+        }
+
+        length = rxBuffer_[FRAME_PAYLOAD + ADDRESS_SIZE];
+        if( length > TxSize )
+        {
+            return STATUS_ERR;
+        }
+
+        blockAddress_ = getAddress(&rxBuffer_[FRAME_PAYLOAD]);
+        blockLength_ = length;
+        isLogging_ = false;
+        return STATUS_SUCCESS;
+    }
+
+    Status setBypassFunction( void )
+    {
+        BypassResponse response;
+
+        response.status = STATUS_ERR;
+        clearBlock();
+
+        if( bypassFunction_ != (bypass_function_t)0 )
+        {
+            countStatistics(&LinkStatistics::bypassCalls);
+            response = bypassFunction_(&rxBuffer_[FRAME_PAYLOAD], rxLength_ - 1);
+            blockAddress_ = (AddrT)(uintptr_t)response.buffer;
+            blockLength_ = (response.length > TxSize) ? TxSize : response.length;
+        }
+
+        isLogging_ = false;
+        return response.status;
+    }
+
+    Status readStatistics( void )
+    {
+        if( rxLength_ != (1 + 1) || rxBuffer_[FRAME_PAYLOAD + 0] != EXTCODE_STATISTICS )
+        {
+            return STATUS_ERR;
+        }
+
+        /* Read-only, logging continues */
+        blockAddress_ = (AddrT)(uintptr_t)&statistics_;
+        blockLength_ = sizeof(statistics_);
+        return STATUS_SUCCESS;
+    }
+
+    /*-- begin: state --*/
+
+    uint8_t rxBuffer_[RxSize];
+    uint16_t rxLength_;
+    RxStatus rxStatus_;
+    uint16_t rxTimeoutCnt_;
+
+    uint8_t txBuffer_[TX_BUFFER_SIZE];
+    uint16_t txCurrentIndex_;
+    uint16_t txMaxIndex_;
+    TxStatus txStatus_;
+
+    uint8_t logSize_[LogMax];
+    AddrT logAddress_[LogMax];
+    uint8_t logCurrentIndex_;
+    uint8_t logAvailableIndex_;
+
+    AddrT blockAddress_;
+    uint16_t blockLength_;
+    AddrT versionAddress_;
+    uint16_t versionLength_;
+
+    bool isLogging_;
+    bool isApproved_;
+    bool isRequestFinished_;
+    uint8_t masCnt_;
+    uint8_t slvCnt_;
+
+    uint16_t millisCnt_;
+    uint16_t logTimeoutCnt_;
+    uint16_t logIntervalCnt_;
+    uint16_t logIntervalPeriod_;
+    uint32_t passKey_;
+
+    detail::Ring<RX_RING_SIZE> rxRing_;
+    typename detail::Select<hasEmulation, detail::Ring<Emulation::inSize>, detail::Empty>::type emulationIn_;
+    typename detail::Select<hasEmulation, detail::Ring<Emulation::outSize>, detail::Empty>::type emulationOut_;
+    typename detail::Select<hasBypass, bypass_function_t, detail::Empty>::type bypassFunction_;
+    typename detail::Select<hasStatistics, LinkStatistics, detail::Empty>::type statistics_;
+};
+
+} // namespace rm
+
+#endif  /* RM_CORE_HPP */
+
+/*-- end of file --*/
@@ -1,11 +1,56 @@
 // This program is the minimal code necessary to achieve communication with RM Classic using ArduinoUnoR3.
 
 #include "RmComm.h"
+#include <EEPROM.h>
 
 uint32_t previousMillis;
 
 uint32_t testCount = 0;
 
+// Variables listed here are published to the host with their current addresses.
+const RM_RegistryEntry rmRegistry[] RM_FLASH =
+{
+  RM_REGISTRY_ENTRY(testCount, RM_TYPE_UNSIGNED),
+};
+
+// Log profiles the host can switch to with a single request.
+const RM_LogProfileEntry rmCountEntries[] RM_FLASH =
+{
+  RM_LOG_PROFILE_ENTRY(testCount),
+};
+
+const RM_LogProfile rmLogProfiles[] RM_FLASH =
+{
+  RM_LOG_PROFILE("count", 100, rmCountEntries),
+};
+
+// The host may only read and write SRAM, I/O registers below RAMSTART are protected.
+const RM_AccessRegion rmAccessRegions[] RM_FLASH =
+{
+  { (const void*)RAMSTART, (RAMEND - RAMSTART + 1), RM_ACCESS_READ | RM_ACCESS_WRITE },
+};
+
+// The log configuration saved by the host is kept in EEPROM from this address.
+const int rmSessionAddress = 0;
+
+bool rm_save_session(uint8_t buffer[], uint16_t size) {
+  for (uint16_t index = 0; index < size; index++) {
+    EEPROM.update(rmSessionAddress + index, buffer[index]);   // only changed bytes are written
+  }
+  return true;
+}
+
+bool rm_load_session(uint8_t buffer[], uint16_t size) {
+  for (uint16_t index = 0; index < size; index++) {
+    buffer[index] = EEPROM.read(rmSessionAddress + index);
+  }
+  return true;
+}
+
+// A saved session is only resumed by the same build. The compile time stands in for a build ID,
+// a build system can pass a git hash or the linker build ID instead.
+const char rmBuildId[] = __DATE__ " " __TIME__;
+
 const char version[] = "ArduinoUnoR3";
 const int versionLength = sizeof(version);
 const int rmIntervalMillis = 10;
@@ -57,6 +102,11 @@ void setup() {
   Serial.begin(9600);
 
   RMComm_Initialize((uint8_t *)version, versionLength, rmIntervalMillis, 0x0000FFFFU);
+  RMComm_AttachRegistry(rmRegistry, sizeof(rmRegistry) / sizeof(rmRegistry[0]));
+  RMComm_AttachAccessRegions(rmAccessRegions, sizeof(rmAccessRegions) / sizeof(rmAccessRegions[0]));
+  RMComm_AttachStorage(rm_save_session, rm_load_session);
+  RMComm_AttachBuildId((const uint8_t *)rmBuildId, sizeof(rmBuildId) - 1);
+  RMComm_AttachLogProfiles(rmLogProfiles, sizeof(rmLogProfiles) / sizeof(rmLogProfiles[0]));
   previousMillisForRM = millis();
   previousMillis = millis();
 }
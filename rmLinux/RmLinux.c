@@ -0,0 +1,868 @@
+//******************************************************************************
+// RmLinux(Linux transport for RmComm)
+// Copyright 2024 Naoya Imai
+//******************************************************************************
+
+#define _GNU_SOURCE
+#include "RmLinux.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <link.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+
+#define RMLINUX_EVENT_LISTEN    1
+#define RMLINUX_EVENT_DATA      2
+#define RMLINUX_EVENT_TIMER     3
+#define RMLINUX_EVENT_WAKEUP    4
+
+#define RMLINUX_EVENT_MAX       8
+#define RMLINUX_TICK_CATCHUP_MAX    100     /* RMComm_Run() calls for one timer event after a stall */
+#define RMLINUX_INVALID_FD      (-1)
+
+/*-- begin: static variables --*/
+RMLinux_Config RMLinux_config;
+
+int RMLinux_epollFd = RMLINUX_INVALID_FD;
+int RMLinux_timerFd = RMLINUX_INVALID_FD;
+int RMLinux_wakeupFd = RMLINUX_INVALID_FD;
+int RMLinux_listenFd = RMLINUX_INVALID_FD;
+int RMLinux_dataFd = RMLINUX_INVALID_FD;
+int RMLinux_ptySlaveFd = RMLINUX_INVALID_FD;
+
+bool RMLinux_isTimerArmed = false;
+bool RMLinux_isTransmitting = false;
+uint32_t RMLinux_dataEvents = 0;
+
+uint8_t  RMLinux_inputBuffer[RMLINUX_INPUT_BUFFER_SIZE];
+uint16_t RMLinux_inputIndex = 0;
+uint16_t RMLinux_inputLength = 0;
+
+uint8_t  RMLinux_outputBuffer[RMLINUX_OUTPUT_BUFFER_SIZE];
+uint16_t RMLinux_outputIndex = 0;
+uint16_t RMLinux_outputLength = 0;
+
+char RMLinux_deviceName[108];
+
+pthread_t RMLinux_thread;
+volatile bool RMLinux_isRunning = false;
+
+
+/*-- begin: prototype of function --*/
+
+bool RMLinux_OpenPty( void );
+bool RMLinux_OpenSocket( void );
+bool RMLinux_AddEvent( int fd, uint32_t events, uint32_t tag );
+void RMLinux_UpdateDataEvents( void );
+void RMLinux_SetTimer( bool isActive );
+void RMLinux_Accept( void );
+void RMLinux_DropClient( void );
+void RMLinux_ReadData( void );
+void RMLinux_Tick( void );
+void RMLinux_CollectTransmitData( void );
+void RMLinux_FlushTransmitData( void );
+void* RMLinux_ThreadMain( void* arg );
+bool RMLinux_SaveSession( uint8_t buffer[], uint16_t size );
+bool RMLinux_LoadSession( uint8_t buffer[], uint16_t size );
+#ifdef RM_SUPPORT_SESSION
+int  RMLinux_FindBuildId( struct dl_phdr_info* info, size_t infoSize, void* data );
+#endif
+
+/*-- begin: functions --*/
+
+/**
+ * @fn bool RMLinux_Open(const RMLinux_Config* pConfig)
+ * @brief Opens the selected backend and prepares the epoll loop.
+ *
+ * RMComm_Initialize() must be called before.
+ *
+ * @param pConfig Pointer to the transport configuration.
+ * @return True if the backend is ready, false otherwise (errno is preserved).
+ */
+bool RMLinux_Open( const RMLinux_Config* pConfig )
+{
+    bool is_opened;
+
+    if( pConfig == NULL || pConfig->millisCount == 0 )
+    {
+        errno = EINVAL;
+        return false;
+    }
+
+    RMLinux_config = *pConfig;
+    RMLinux_inputIndex = 0;
+    RMLinux_inputLength = 0;
+    RMLinux_outputIndex = 0;
+    RMLinux_outputLength = 0;
+    RMLinux_isTransmitting = false;
+    RMLinux_isTimerArmed = false;
+    RMLinux_deviceName[0] = '\0';
+
+    RMLinux_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    RMLinux_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    RMLinux_wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if( RMLinux_epollFd < 0 || RMLinux_timerFd < 0 || RMLinux_wakeupFd < 0 )
+    {
+        goto RMLINUX_LABEL_OPEN_FAILED;
+    }
+
+    if( !RMLinux_AddEvent(RMLinux_timerFd, EPOLLIN, RMLINUX_EVENT_TIMER) ||
+        !RMLinux_AddEvent(RMLinux_wakeupFd, EPOLLIN, RMLINUX_EVENT_WAKEUP) )
+    {
+        goto RMLINUX_LABEL_OPEN_FAILED;
+    }
+
+#ifdef RM_SUPPORT_SESSION
+    if( RMLinux_config.sessionPath != NULL )
+    {
+        RMComm_AttachStorage(RMLinux_SaveSession, RMLinux_LoadSession);
+        dl_iterate_phdr(RMLinux_FindBuildId, NULL);
+    }
+#endif
+
+    switch( RMLinux_config.backend )
+    {
+    case RMLINUX_BACKEND_PTY:
+        is_opened = RMLinux_OpenPty();
+        break;
+
+    case RMLINUX_BACKEND_UNIX:
+    case RMLINUX_BACKEND_TCP:
+        is_opened = RMLinux_OpenSocket();
+        break;
+
+    default:
+        errno = EINVAL;
+        is_opened = false;
+        break;
+    }
+
+    if( is_opened )
+    {
+        return true;
+    }
+
+RMLINUX_LABEL_OPEN_FAILED:
+    {
+        int error = errno;
+        RMLinux_Close();
+        errno = error;
+    }
+    return false;
+}
+
+/**
+ * @fn bool RMLinux_Poll(int timeoutMillis)
+ * @brief Waits for transport events and processes them.
+ *
+ * Use this from the application's own loop instead of RMLinux_Start().
+ *
+ * @param timeoutMillis Maximum waiting time, -1 waits indefinitely.
+ * @return True unless epoll_wait() failed.
+ */
+bool RMLinux_Poll( int timeoutMillis )
+{
+    struct epoll_event events[RMLINUX_EVENT_MAX];
+    uint64_t counter;
+    int count;
+    int index;
+
+    count = epoll_wait(RMLinux_epollFd, events, RMLINUX_EVENT_MAX, timeoutMillis);
+    if( count < 0 )
+    {
+        return errno == EINTR;
+    }
+
+    for( index = 0; index < count; index++ )
+    {
+        switch( events[index].data.u32 )
+        {
+        case RMLINUX_EVENT_LISTEN:
+            RMLinux_Accept();
+            break;
+
+        case RMLINUX_EVENT_DATA:
+            if( RMLinux_dataFd == RMLINUX_INVALID_FD )
+            {
+                break;  /* dropped by a previous event of this batch */
+            }
+
+            if( events[index].events & (EPOLLIN | EPOLLHUP | EPOLLERR) )
+            {
+                RMLinux_ReadData();
+            }
+
+            if( (events[index].events & EPOLLOUT) && RMLinux_dataFd != RMLINUX_INVALID_FD )
+            {
+                RMLinux_FlushTransmitData();
+            }
+            break;
+
+        case RMLINUX_EVENT_TIMER:
+            RMLinux_Tick();
+            break;
+
+        case RMLINUX_EVENT_WAKEUP:
+            while( read(RMLinux_wakeupFd, &counter, sizeof(counter)) > 0 )
+            {
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @fn bool RMLinux_Start(void)
+ * @brief Runs the epoll loop in a dedicated thread.
+ *
+ * @return True if the thread is started.
+ */
+bool RMLinux_Start( void )
+{
+    int result;
+
+    if( RMLinux_isRunning )
+    {
+        return true;
+    }
+
+    RMLinux_isRunning = true;
+    result = pthread_create(&RMLinux_thread, NULL, RMLinux_ThreadMain, NULL);
+    if( result != 0 )
+    {
+        RMLinux_isRunning = false;
+        errno = result;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @fn void RMLinux_Stop(void)
+ * @brief Stops the thread started by RMLinux_Start().
+ */
+void RMLinux_Stop( void )
+{
+    uint64_t counter = 1;
+
+    if( !RMLinux_isRunning )
+    {
+        return;
+    }
+
+    RMLinux_isRunning = false;
+    if( write(RMLinux_wakeupFd, &counter, sizeof(counter)) < 0 )
+    {
+        /* The thread still leaves at the next event */
+    }
+    pthread_join(RMLinux_thread, NULL);
+}
+
+/**
+ * @fn void RMLinux_Close(void)
+ * @brief Stops the transport and releases every descriptor.
+ */
+void RMLinux_Close( void )
+{
+    RMLinux_Stop();
+
+    RMLinux_DropClient();
+
+    if( RMLinux_listenFd != RMLINUX_INVALID_FD )
+    {
+        close(RMLinux_listenFd);
+        RMLinux_listenFd = RMLINUX_INVALID_FD;
+        if( RMLinux_config.backend == RMLINUX_BACKEND_UNIX && RMLinux_config.path != NULL )
+        {
+            unlink(RMLinux_config.path);
+        }
+    }
+
+    if( RMLinux_ptySlaveFd != RMLINUX_INVALID_FD )
+    {
+        close(RMLinux_ptySlaveFd);
+        RMLinux_ptySlaveFd = RMLINUX_INVALID_FD;
+        if( RMLinux_config.path != NULL )
+        {
+            unlink(RMLinux_config.path);
+        }
+    }
+
+    if( RMLinux_timerFd != RMLINUX_INVALID_FD )
+    {
+        close(RMLinux_timerFd);
+        RMLinux_timerFd = RMLINUX_INVALID_FD;
+    }
+
+    if( RMLinux_wakeupFd != RMLINUX_INVALID_FD )
+    {
+        close(RMLinux_wakeupFd);
+        RMLinux_wakeupFd = RMLINUX_INVALID_FD;
+    }
+
+    if( RMLinux_epollFd != RMLINUX_INVALID_FD )
+    {
+        close(RMLinux_epollFd);
+        RMLinux_epollFd = RMLINUX_INVALID_FD;
+    }
+}
+
+/**
+ * @fn const char* RMLinux_GetDeviceName(void)
+ * @brief Returns the slave device of the pty backend, or an empty string.
+ */
+const char* RMLinux_GetDeviceName( void )
+{
+    return RMLinux_deviceName;
+}
+
+/**
+ * @fn bool RMLinux_OpenPty(void)
+ * @brief Creates a pseudo-terminal in raw mode and publishes its slave device.
+ *
+ * The slave side is kept open so that the master never reports a hang-up while no host is attached.
+ */
+bool RMLinux_OpenPty( void )
+{
+    struct termios tio;
+    const char* name;
+
+    RMLinux_dataFd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if( RMLinux_dataFd < 0 )
+    {
+        return false;
+    }
+
+    if( grantpt(RMLinux_dataFd) != 0 || unlockpt(RMLinux_dataFd) != 0 )
+    {
+        return false;
+    }
+
+    name = ptsname(RMLinux_dataFd);
+    if( name == NULL )
+    {
+        return false;
+    }
+    strncpy(RMLinux_deviceName, name, sizeof(RMLinux_deviceName) - 1);
+    RMLinux_deviceName[sizeof(RMLinux_deviceName) - 1] = '\0';
+
+    RMLinux_ptySlaveFd = open(RMLinux_deviceName, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if( RMLinux_ptySlaveFd < 0 )
+    {
+        return false;
+    }
+
+    if( tcgetattr(RMLinux_ptySlaveFd, &tio) == 0 )
+    {
+        cfmakeraw(&tio);
+        tcsetattr(RMLinux_ptySlaveFd, TCSANOW, &tio);
+    }
+
+    if( RMLinux_config.path != NULL )
+    {
+        unlink(RMLinux_config.path);
+        if( symlink(RMLinux_deviceName, RMLinux_config.path) != 0 )
+        {
+            return false;
+        }
+    }
+
+    RMLinux_dataEvents = EPOLLIN;
+    return RMLinux_AddEvent(RMLinux_dataFd, RMLinux_dataEvents, RMLINUX_EVENT_DATA);
+}
+
+/**
+ * @fn bool RMLinux_OpenSocket(void)
+ * @brief Creates the listening UNIX or localhost TCP socket.
+ */
+bool RMLinux_OpenSocket( void )
+{
+    struct sockaddr_un unix_address;
+    struct sockaddr_in tcp_address;
+    struct sockaddr* address;
+    socklen_t address_size;
+    int option = 1;
+
+    if( RMLinux_config.backend == RMLINUX_BACKEND_UNIX )
+    {
+        if( RMLinux_config.path == NULL || strlen(RMLinux_config.path) >= sizeof(unix_address.sun_path) )
+        {
+            errno = EINVAL;
+            return false;
+        }
+
+        memset(&unix_address, 0, sizeof(unix_address));
+        unix_address.sun_family = AF_UNIX;
+        strcpy(unix_address.sun_path, RMLinux_config.path);
+        unlink(RMLinux_config.path);
+
+        address = (struct sockaddr*)&unix_address;
+        address_size = sizeof(unix_address);
+        strcpy(RMLinux_deviceName, RMLinux_config.path);
+    }
+    else
+    {
+        memset(&tcp_address, 0, sizeof(tcp_address));
+        tcp_address.sin_family = AF_INET;
+        tcp_address.sin_port = htons(RMLinux_config.port);
+        tcp_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        address = (struct sockaddr*)&tcp_address;
+        address_size = sizeof(tcp_address);
+    }
+
+    RMLinux_listenFd = socket(address->sa_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if( RMLinux_listenFd < 0 )
+    {
+        return false;
+    }
+
+    if( RMLinux_config.backend == RMLINUX_BACKEND_TCP )
+    {
+        setsockopt(RMLinux_listenFd, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+    }
+
+    if( bind(RMLinux_listenFd, address, address_size) != 0 ||
+        listen(RMLinux_listenFd, 1) != 0 )
+    {
+        return false;
+    }
+
+    return RMLinux_AddEvent(RMLinux_listenFd, EPOLLIN, RMLINUX_EVENT_LISTEN);
+}
+
+bool RMLinux_AddEvent( int fd, uint32_t events, uint32_t tag )
+{
+    struct epoll_event event;
+
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.u32 = tag;
+
+    return epoll_ctl(RMLinux_epollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+/**
+ * @fn void RMLinux_UpdateDataEvents(void)
+ * @brief Reads only while the input buffer has room and waits for EPOLLOUT only while output is pending.
+ */
+void RMLinux_UpdateDataEvents( void )
+{
+    struct epoll_event event;
+    uint32_t events = 0;
+
+    if( RMLinux_dataFd == RMLINUX_INVALID_FD )
+    {
+        return;
+    }
+
+    if( RMLinux_inputLength < sizeof(RMLinux_inputBuffer) )
+    {
+        events |= EPOLLIN;
+    }
+
+    if( RMLinux_outputIndex < RMLinux_outputLength )
+    {
+        events |= EPOLLOUT;
+    }
+
+    if( events == RMLinux_dataEvents )
+    {
+        return;
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.u32 = RMLINUX_EVENT_DATA;
+    epoll_ctl(RMLinux_epollFd, EPOLL_CTL_MOD, RMLinux_dataFd, &event);
+    RMLinux_dataEvents = events;
+}
+
+/**
+ * @fn void RMLinux_SetTimer(bool isActive)
+ * @brief Starts the RMComm_Run() period at once, or stops it.
+ */
+void RMLinux_SetTimer( bool isActive )
+{
+    struct itimerspec spec;
+
+    if( isActive == RMLinux_isTimerArmed )
+    {
+        return;
+    }
+
+    memset(&spec, 0, sizeof(spec));
+    if( isActive )
+    {
+        spec.it_value.tv_nsec = 1;
+        spec.it_interval.tv_sec = RMLinux_config.millisCount / 1000;
+        spec.it_interval.tv_nsec = (long)(RMLinux_config.millisCount % 1000) * 1000000L;
+    }
+
+    timerfd_settime(RMLinux_timerFd, 0, &spec, NULL);
+    RMLinux_isTimerArmed = isActive;
+}
+
+/**
+ * @fn void RMLinux_Accept(void)
+ * @brief Accepts a host connection, replacing the previous one.
+ */
+void RMLinux_Accept( void )
+{
+    int fd;
+    int option = 1;
+
+    fd = accept4(RMLinux_listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if( fd < 0 )
+    {
+        return;
+    }
+
+    RMLinux_DropClient();
+
+    if( RMLinux_config.backend == RMLINUX_BACKEND_TCP )
+    {
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &option, sizeof(option));
+    }
+
+    RMLinux_dataFd = fd;
+    RMLinux_dataEvents = EPOLLIN;
+    if( !RMLinux_AddEvent(RMLinux_dataFd, RMLinux_dataEvents, RMLINUX_EVENT_DATA) )
+    {
+        RMLinux_DropClient();
+    }
+}
+
+/**
+ * @fn void RMLinux_DropClient(void)
+ * @brief Closes the host connection and discards its pending data.
+ */
+void RMLinux_DropClient( void )
+{
+    if( RMLinux_dataFd != RMLINUX_INVALID_FD )
+    {
+        if( RMLinux_epollFd != RMLINUX_INVALID_FD )
+        {
+            epoll_ctl(RMLinux_epollFd, EPOLL_CTL_DEL, RMLinux_dataFd, NULL);
+        }
+        close(RMLinux_dataFd);
+        RMLinux_dataFd = RMLINUX_INVALID_FD;
+    }
+
+    RMLinux_inputIndex = 0;
+    RMLinux_inputLength = 0;
+    RMLinux_outputIndex = 0;
+    RMLinux_outputLength = 0;
+}
+
+/**
+ * @fn void RMLinux_ReadData(void)
+ * @brief Buffers received bytes; they are passed to RMComm at the next tick.
+ */
+void RMLinux_ReadData( void )
+{
+    ssize_t size;
+
+    if( RMLinux_inputIndex > 0 )
+    {
+        memmove(&RMLinux_inputBuffer[0], &RMLinux_inputBuffer[RMLinux_inputIndex], RMLinux_inputLength - RMLinux_inputIndex);
+        RMLinux_inputLength -= RMLinux_inputIndex;
+        RMLinux_inputIndex = 0;
+    }
+
+    while( RMLinux_inputLength < sizeof(RMLinux_inputBuffer) )
+    {
+        size = read(RMLinux_dataFd, &RMLinux_inputBuffer[RMLinux_inputLength], sizeof(RMLinux_inputBuffer) - RMLinux_inputLength);
+        if( size > 0 )
+        {
+            RMLinux_inputLength += (uint16_t)size;
+        }
+        else if( size < 0 && errno == EINTR )
+        {
+            continue;
+        }
+        else
+        {
+            if( (size == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) &&
+                RMLinux_config.backend != RMLINUX_BACKEND_PTY )
+            {
+                /* The host closed the connection */
+                RMLinux_DropClient();
+                return;
+            }
+            break;
+        }
+    }
+
+    if( RMLinux_inputIndex < RMLinux_inputLength )
+    {
+        RMLinux_SetTimer(true);
+    }
+
+    RMLinux_UpdateDataEvents();
+}
+
+/**
+ * @fn void RMLinux_Tick(void)
+ * @brief Processes the expired periods of RMComm_Run().
+ */
+void RMLinux_Tick( void )
+{
+    RMComm_RingStatus status;
+    uint64_t expirations = 0;
+    uint16_t space;
+
+    if( read(RMLinux_timerFd, &expirations, sizeof(expirations)) != sizeof(expirations) )
+    {
+        return;
+    }
+
+    if( expirations > RMLINUX_TICK_CATCHUP_MAX )
+    {
+        expirations = RMLINUX_TICK_CATCHUP_MAX;
+    }
+
+    while( expirations-- > 0 )
+    {
+        /* Never pass more bytes than the RMComm receive buffer holds, as rm_bg() does */
+        RMComm_GetRingStatus(RMCOMM_RING_RECEIVE, &status);
+        space = status.capacity - status.used;
+        while( space > 0 && RMLinux_inputIndex < RMLinux_inputLength )
+        {
+            RMComm_SetReceivedData(RMLinux_inputBuffer[RMLinux_inputIndex]);
+            RMLinux_inputIndex++;
+            space--;
+        }
+
+        RMComm_Run();
+
+        RMLinux_CollectTransmitData();
+        RMLinux_FlushTransmitData();
+    }
+
+    if( RMLinux_inputIndex == RMLinux_inputLength &&
+        RMLinux_outputIndex == RMLinux_outputLength &&
+        RMLinux_isTransmitting == false &&
+        RMComm_IsIdle() )
+    {
+        RMLinux_SetTimer(false);
+    }
+
+    RMLinux_UpdateDataEvents();
+}
+
+/**
+ * @fn void RMLinux_CollectTransmitData(void)
+ * @brief Emulates the transmission interrupts of rm_bg() into the output buffer.
+ */
+void RMLinux_CollectTransmitData( void )
+{
+    uint8_t data;
+
+    if( RMLinux_outputIndex == RMLinux_outputLength )
+    {
+        RMLinux_outputIndex = 0;
+        RMLinux_outputLength = 0;
+    }
+
+    if( RMLinux_isTransmitting == false )
+    {
+        if( !RMComm_TryTransmission(&data) )
+        {
+            return;
+        }
+        RMLinux_isTransmitting = true;
+        RMLinux_outputBuffer[RMLinux_outputLength++] = data;
+    }
+
+    while( RMLinux_outputLength < sizeof(RMLinux_outputBuffer) )
+    {
+        if( !RMComm_GetTransmitData(&data) )
+        {
+            RMLinux_isTransmitting = false;
+            break;
+        }
+        RMLinux_outputBuffer[RMLinux_outputLength++] = data;
+    }
+}
+
+/**
+ * @fn void RMLinux_FlushTransmitData(void)
+ * @brief Writes the output buffer without blocking; the rest waits for EPOLLOUT.
+ */
+void RMLinux_FlushTransmitData( void )
+{
+    ssize_t size;
+
+    while( RMLinux_outputIndex < RMLinux_outputLength )
+    {
+        if( RMLinux_dataFd == RMLINUX_INVALID_FD )
+        {
+            /* No host is connected, the frame is lost as on an open serial line */
+            RMLinux_outputIndex = RMLinux_outputLength;
+            break;
+        }
+
+        size = write(RMLinux_dataFd, &RMLinux_outputBuffer[RMLinux_outputIndex], RMLinux_outputLength - RMLinux_outputIndex);
+        if( size > 0 )
+        {
+            RMLinux_outputIndex += (uint16_t)size;
+        }
+        else if( size < 0 && errno == EINTR )
+        {
+            continue;
+        }
+        else
+        {
+            if( errno != EAGAIN && errno != EWOULDBLOCK && RMLinux_config.backend != RMLINUX_BACKEND_PTY )
+            {
+                RMLinux_DropClient();
+            }
+            break;
+        }
+
+        if( RMLinux_outputIndex == RMLinux_outputLength && RMLinux_isTransmitting )
+        {
+            RMLinux_CollectTransmitData();
+        }
+    }
+
+    RMLinux_UpdateDataEvents();
+}
+
+void* RMLinux_ThreadMain( void* arg )
+{
+    (void)arg;
+
+    while( RMLinux_isRunning )
+    {
+        if( !RMLinux_Poll(-1) )
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @fn bool RMLinux_SaveSession(uint8_t buffer[], uint16_t size)
+ * @brief Storage hook writing the session record to sessionPath.
+ *
+ * The record is written to a temporary file and renamed, so a crash never leaves a partial record.
+ */
+bool RMLinux_SaveSession( uint8_t buffer[], uint16_t size )
+{
+    char temp_path[256];
+    int fd;
+    bool is_saved;
+
+    if( snprintf(temp_path, sizeof(temp_path), "%s.tmp", RMLinux_config.sessionPath) >= (int)sizeof(temp_path) )
+    {
+        return false;
+    }
+
+    fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if( fd < 0 )
+    {
+        return false;
+    }
+
+    is_saved = (write(fd, buffer, size) == (ssize_t)size);
+    close(fd);
+
+    if( !is_saved || rename(temp_path, RMLinux_config.sessionPath) != 0 )
+    {
+        unlink(temp_path);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @fn bool RMLinux_LoadSession(uint8_t buffer[], uint16_t size)
+ * @brief Storage hook reading the session record from sessionPath.
+ */
+bool RMLinux_LoadSession( uint8_t buffer[], uint16_t size )
+{
+    int fd;
+    bool is_loaded;
+
+    fd = open(RMLinux_config.sessionPath, O_RDONLY | O_CLOEXEC);
+    if( fd < 0 )
+    {
+        return false;
+    }
+
+    is_loaded = (read(fd, buffer, size) == (ssize_t)size);
+    close(fd);
+
+    return is_loaded;
+}
+
+#ifdef RM_SUPPORT_SESSION
+/**
+ * @fn int RMLinux_FindBuildId(struct dl_phdr_info* info, size_t infoSize, void* data)
+ * @brief dl_iterate_phdr() callback attaching the GNU build ID of the executable to the session record.
+ *
+ * The executable is reported first, so the walk stops there. Without a build ID (ld --build-id=none)
+ * a rebuild that keeps the version string may resume a record of the previous build.
+ */
+int RMLinux_FindBuildId( struct dl_phdr_info* info, size_t infoSize, void* data )
+{
+    const ElfW(Nhdr)* note;
+    uintptr_t position;
+    uintptr_t end;
+    int index;
+
+    (void)infoSize;
+    (void)data;
+
+    for( index = 0; index < info->dlpi_phnum; index++ )
+    {
+        if( info->dlpi_phdr[index].p_type != PT_NOTE )
+        {
+            continue;
+        }
+
+        position = info->dlpi_addr + info->dlpi_phdr[index].p_vaddr;
+        end = position + info->dlpi_phdr[index].p_memsz;
+        while( position + sizeof(*note) <= end )
+        {
+            note = (const ElfW(Nhdr)*)position;
+            position += sizeof(*note) + ((note->n_namesz + 3) & ~3U);
+            if( (note->n_type == NT_GNU_BUILD_ID) && (note->n_namesz == 4) &&
+                (memcmp(note + 1, "GNU", 4) == 0) && (position + note->n_descsz <= end) )
+            {
+                RMComm_AttachBuildId((const uint8_t*)position, (uint16_t)note->n_descsz);
+                return 1;
+            }
+            position += (note->n_descsz + 3) & ~3U;
+        }
+    }
+
+    return 1;
+}
+#endif
+
+/*-- end of file --*/
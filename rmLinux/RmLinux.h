@@ -0,0 +1,61 @@
+#ifndef RM_LINUX_H
+#define RM_LINUX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "RmComm.h"
+
+/*
+ * Linux transport for RMComm.
+ *
+ * The transport owns an epoll loop that reads the host connection, calls RMComm_Run()
+ * every millisCount from a timerfd and writes the encoded frames back. The timer is
+ * stopped while RMComm_IsIdle() reports nothing to do, so an idle process costs no CPU.
+ *
+ * RMComm is not thread-safe. Once RMLinux_Start() is called, RMComm_Run() and the
+ * transmit functions belong to the transport thread; the application may only use
+ * RMComm_Write()/RMComm_Print*() (single producer) and RMComm_Read() (single consumer).
+ *
+ * Build example:
+ *   cc -O2 -g -no-pie -I../rmDemo rmLinuxDemo.c RmLinux.c ../rmDemo/RmCore.c ../rmDemo/RmComm.c -lpthread
+ *
+ * -no-pie keeps the variables at the addresses of the ELF image, which is what tools/rmSym
+ * and RM Classic view files expect. Distributions build PIE by default, and a PIE process is
+ * loaded at a random address on every run; rmSym then needs that address with -b.
+ */
+
+#define RMLINUX_INPUT_BUFFER_SIZE   4096
+#define RMLINUX_OUTPUT_BUFFER_SIZE  (2 * RM_SND_FRAME_BUFF_SIZE + 2)   /* worst case of a SLIP encoded frame */
+
+typedef enum
+{
+  RMLINUX_BACKEND_PTY = 0,  // pseudo-terminal, path is an optional symlink to the slave device
+  RMLINUX_BACKEND_UNIX,     // UNIX domain stream socket bound to path
+  RMLINUX_BACKEND_TCP       // TCP socket bound to 127.0.0.1:port
+} RMLinux_Backend;
+
+typedef struct RMLINUX_CONFIG
+{
+    RMLinux_Backend backend;
+    const char* path;
+    uint16_t port;
+    uint16_t millisCount;   // period of RMComm_Run(), same value as passed to RMComm_Initialize()
+    const char* sessionPath;    // optional file keeping the RM_SessionRecord across restarts
+} RMLinux_Config;
+
+bool RMLinux_Open( const RMLinux_Config* pConfig );
+bool RMLinux_Poll( int timeoutMillis );
+bool RMLinux_Start( void );
+void RMLinux_Stop( void );
+void RMLinux_Close( void );
+const char* RMLinux_GetDeviceName( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* RM_LINUX_H */
+
+/*-- end of file --*/
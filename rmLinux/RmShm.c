@@ -0,0 +1,267 @@
+//******************************************************************************
+// RmShm(Shared-memory ring of log samples)
+// Copyright 2024 Naoya Imai
+//******************************************************************************
+
+#include "RmShm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define RMSHM_SLOT_SIZE     ((uint16_t)((sizeof(RMShm_Slot) + 7) & ~(size_t)7))
+
+/*-- begin: prototype of function --*/
+
+RMShm_Slot* RMShm_GetSlot( RMShm_Ring* pRing, uint64_t index );
+
+/*-- begin: functions --*/
+
+/**
+ * @fn bool RMShm_Create(RMShm_Ring* pRing, const char* name, uint32_t slotCount)
+ * @brief Creates the shared-memory object as the producer.
+ *
+ * @param pRing Pointer to the ring to initialize.
+ * @param name POSIX shared-memory name, such as "/rm_myservice".
+ * @param slotCount Number of samples kept, rounded down to a power of 2.
+ * @return True if the ring is mapped, false otherwise (errno is preserved).
+ */
+bool RMShm_Create( RMShm_Ring* pRing, const char* name, uint32_t slotCount )
+{
+    int fd;
+    void* map;
+    uint32_t count;
+
+    if( slotCount < 2 || strlen(name) >= sizeof(pRing->name) )
+    {
+        errno = EINVAL;
+        return false;
+    }
+
+    count = 1;
+    while( (count << 1) <= slotCount && (count << 1) != 0 )
+    {
+        count = count << 1;
+    }
+
+    memset(pRing, 0, sizeof(*pRing));
+    pRing->mapSize = sizeof(RMShm_Header) + (uint64_t)count * RMSHM_SLOT_SIZE;
+
+    fd = shm_open(name, O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+    if( fd < 0 )
+    {
+        return false;
+    }
+
+    if( ftruncate(fd, (off_t)pRing->mapSize) != 0 )
+    {
+        close(fd);
+        return false;
+    }
+
+    map = mmap(NULL, pRing->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if( map == MAP_FAILED )
+    {
+        return false;
+    }
+
+    pRing->header = (RMShm_Header*)map;
+    pRing->slots = (uint8_t*)map + sizeof(RMShm_Header);
+    pRing->mask = count - 1;
+    pRing->isOwner = true;
+    strcpy(pRing->name, name);
+
+    memset(map, 0, pRing->mapSize);
+    pRing->header->version = RMSHM_VERSION;
+    pRing->header->slotSize = RMSHM_SLOT_SIZE;
+    pRing->header->slotCount = count;
+    __atomic_store_n(&pRing->header->magic, RMSHM_MAGIC, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * @fn bool RMShm_Attach(RMShm_Ring* pRing, const char* name)
+ * @brief Maps an existing ring read-only as a sidecar.
+ *
+ * @param pRing Pointer to the ring to initialize.
+ * @param name POSIX shared-memory name given to RMShm_Create().
+ * @return True if the ring is mapped and compatible, false otherwise.
+ */
+bool RMShm_Attach( RMShm_Ring* pRing, const char* name )
+{
+    int fd;
+    void* map;
+    struct stat info;
+    RMShm_Header* header;
+
+    memset(pRing, 0, sizeof(*pRing));
+
+    fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if( fd < 0 )
+    {
+        return false;
+    }
+
+    if( fstat(fd, &info) != 0 || (uint64_t)info.st_size < sizeof(RMShm_Header) )
+    {
+        close(fd);
+        errno = EINVAL;
+        return false;
+    }
+
+    map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if( map == MAP_FAILED )
+    {
+        return false;
+    }
+
+    header = (RMShm_Header*)map;
+    if( __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != RMSHM_MAGIC ||
+        header->version != RMSHM_VERSION ||
+        header->slotSize != RMSHM_SLOT_SIZE ||
+        header->slotCount < 2 ||
+        (header->slotCount & (header->slotCount - 1)) != 0 ||
+        sizeof(RMShm_Header) + (uint64_t)header->slotCount * header->slotSize > (uint64_t)info.st_size )
+    {
+        munmap(map, (size_t)info.st_size);
+        errno = EPROTO;
+        return false;
+    }
+
+    pRing->header = header;
+    pRing->slots = (uint8_t*)map + sizeof(RMShm_Header);
+    pRing->mapSize = (uint64_t)info.st_size;
+    pRing->mask = header->slotCount - 1;
+    pRing->isOwner = false;
+
+    return true;
+}
+
+/**
+ * @fn void RMShm_Close(RMShm_Ring* pRing)
+ * @brief Unmaps the ring; the producer also removes the shared-memory name.
+ */
+void RMShm_Close( RMShm_Ring* pRing )
+{
+    if( pRing->header == NULL )
+    {
+        return;
+    }
+
+    munmap(pRing->header, pRing->mapSize);
+    if( pRing->isOwner )
+    {
+        shm_unlink(pRing->name);
+    }
+
+    memset(pRing, 0, sizeof(*pRing));
+}
+
+/**
+ * @fn bool RMShm_Sample(RMShm_Ring* pRing, uint64_t timestamp)
+ * @brief Gathers the log table into the next slot and publishes it.
+ *
+ * @param pRing Pointer to a ring created by RMShm_Create().
+ * @param timestamp Any time stamp of the caller, stored with the sample.
+ * @return True if a sample is published, false if no log table is set.
+ */
+bool RMShm_Sample( RMShm_Ring* pRing, uint64_t timestamp )
+{
+    RMShm_Slot* slot;
+    uint8_t data[RMSHM_DATA_SIZE];
+    uint64_t index;
+    uint16_t length;
+
+    /* Without a log table the oldest published sample stays readable */
+    length = RMComm_GatherLogData(data);
+    if( length == 0 )
+    {
+        return false;
+    }
+
+    index = pRing->header->writeIndex;     /* only the producer writes it */
+    slot = RMShm_GetSlot(pRing, index);
+
+    /* Readers that see 0 know this slot is being rewritten */
+    __atomic_store_n(&slot->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    memcpy(slot->data, data, length);
+    slot->timestamp = timestamp;
+    slot->length = length;
+
+    __atomic_store_n(&slot->sequence, index + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&pRing->header->writeIndex, index + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * @fn int RMShm_Read(RMShm_Ring* pRing, uint64_t* pReadIndex, uint8_t buffer[], uint64_t* pTimestamp, uint64_t* pLostCount)
+ * @brief Copies the next sample after *pReadIndex.
+ *
+ * Start with *pReadIndex = 0 to read the oldest sample still in the ring.
+ *
+ * @param pRing Pointer to a ring attached by RMShm_Attach().
+ * @param pReadIndex Reader position, advanced past the returned or lost samples.
+ * @param buffer Array of at least RMSHM_DATA_SIZE bytes.
+ * @param pTimestamp Pointer to store the time stamp of the sample.
+ * @param pLostCount Pointer to add the number of samples overwritten before they were read.
+ * @return The sample length, or 0 if no new sample is published.
+ */
+int RMShm_Read( RMShm_Ring* pRing, uint64_t* pReadIndex, uint8_t buffer[], uint64_t* pTimestamp, uint64_t* pLostCount )
+{
+    RMShm_Slot* slot;
+    uint64_t write_index;
+    uint64_t sequence;
+    uint16_t length;
+
+    while( 1 )
+    {
+        write_index = __atomic_load_n(&pRing->header->writeIndex, __ATOMIC_ACQUIRE);
+        if( *pReadIndex >= write_index )
+        {
+            return 0;
+        }
+
+        if( (write_index - *pReadIndex) > ((uint64_t)pRing->mask + 1) )
+        {
+            *pLostCount += write_index - *pReadIndex - ((uint64_t)pRing->mask + 1);
+            *pReadIndex = write_index - ((uint64_t)pRing->mask + 1);
+        }
+
+        slot = RMShm_GetSlot(pRing, *pReadIndex);
+
+        sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        length = slot->length;
+        if( sequence == (*pReadIndex + 1) && length <= RMSHM_DATA_SIZE )
+        {
+            memcpy(buffer, slot->data, length);
+            *pTimestamp = slot->timestamp;
+
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if( __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == sequence )
+            {
+                (*pReadIndex)++;
+                return length;
+            }
+        }
+
+        /* The producer lapped this slot while it was read */
+        (*pLostCount)++;
+        (*pReadIndex)++;
+    }
+}
+
+RMShm_Slot* RMShm_GetSlot( RMShm_Ring* pRing, uint64_t index )
+{
+    return (RMShm_Slot*)(pRing->slots + (size_t)(index & pRing->mask) * RMSHM_SLOT_SIZE);
+}
+
+/*-- end of file --*/
@@ -0,0 +1,76 @@
+#ifndef RM_SHM_H
+#define RM_SHM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "RmComm.h"
+
+/*
+ * Shared-memory ring of log samples for sidecar processes.
+ *
+ * The monitored process calls RMShm_Sample() at any rate; it gathers the log table
+ * configured by the host (RM_SetLogData), copies it into the next ring slot and publishes
+ * it with a release store. There is no lock, no SLIP framing and no syscall on this path.
+ * While no log table is set, RMShm_Sample() returns false and leaves every slot as it was.
+ * A sidecar maps the same object read-only and follows the writer with RMShm_Read().
+ *
+ * There is one producer, and a ring has at least 2 slots; RMShm_Attach() rejects any other
+ * header. Slots that the producer overwrites before the sidecar reads them are reported
+ * as lost, never returned torn.
+ *
+ * RMShm_Sample() reads the RMComm log table, so it must run in the same context as
+ * RMComm_Run() (for example RMLinux_Poll(0) in the same loop).
+ *
+ * Build example (add -lrt on glibc older than 2.34):
+ *   cc -O2 -I../rmDemo app.c RmShm.c RmLinux.c ../rmDemo/RmCore.c ../rmDemo/RmComm.c -lpthread
+ */
+
+#define RMSHM_MAGIC             0x48534D52UL   /* "RMSH" */
+#define RMSHM_VERSION           1
+#define RMSHM_DATA_SIZE         RM_SND_PAYLOAD_SIZE
+
+typedef struct RMSHM_HEADER
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t slotSize;
+    uint32_t slotCount;         // power of 2
+    uint32_t reserved;
+    uint64_t writeIndex;        // number of published samples
+    uint8_t  padding[40];       // keeps the slots on their own cache lines
+} RMShm_Header;
+
+typedef struct RMSHM_SLOT
+{
+    uint64_t sequence;          // sample index + 1 once published, 0 while being written
+    uint64_t timestamp;         // passed to RMShm_Sample()
+    uint16_t length;
+    uint8_t  data[RMSHM_DATA_SIZE];
+} RMShm_Slot;
+
+typedef struct RMSHM_RING
+{
+    RMShm_Header* header;
+    uint8_t* slots;
+    uint64_t mapSize;
+    uint32_t mask;
+    bool isOwner;
+    char name[64];
+} RMShm_Ring;
+
+bool RMShm_Create( RMShm_Ring* pRing, const char* name, uint32_t slotCount );
+bool RMShm_Attach( RMShm_Ring* pRing, const char* name );
+void RMShm_Close( RMShm_Ring* pRing );
+
+bool RMShm_Sample( RMShm_Ring* pRing, uint64_t timestamp );
+int  RMShm_Read( RMShm_Ring* pRing, uint64_t* pReadIndex, uint8_t buffer[], uint64_t* pTimestamp, uint64_t* pLostCount );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* RM_SHM_H */
+
+/*-- end of file --*/
@@ -0,0 +1,74 @@
+// This program is the minimal code necessary to monitor a Linux process with RM Classic.
+//
+// usage: rmLinuxDemo pty [symlink] | unix <path> | tcp <port>
+
+#include "RmLinux.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+uint32_t testCount = 0;
+
+const RM_RegistryEntry rmRegistry[] =
+{
+    RM_REGISTRY_ENTRY(testCount, RM_TYPE_UNSIGNED),
+};
+
+const char version[] = "LinuxDemo";
+const int versionLength = sizeof(version);
+const int rmIntervalMillis = 10;
+
+int main(int argc, char* argv[])
+{
+    RMLinux_Config config;
+    struct timespec interval = { 1, 0 };
+
+    memset(&config, 0, sizeof(config));
+    config.millisCount = rmIntervalMillis;
+    config.sessionPath = "rmLinuxDemo.session";    // lets the host resume logging after a restart
+
+    if( argc >= 2 && strcmp(argv[1], "pty") == 0 )
+    {
+        config.backend = RMLINUX_BACKEND_PTY;
+        config.path = (argc >= 3) ? argv[2] : NULL;
+    }
+    else if( argc >= 3 && strcmp(argv[1], "unix") == 0 )
+    {
+        config.backend = RMLINUX_BACKEND_UNIX;
+        config.path = argv[2];
+    }
+    else if( argc >= 3 && strcmp(argv[1], "tcp") == 0 )
+    {
+        config.backend = RMLINUX_BACKEND_TCP;
+        config.port = (uint16_t)atoi(argv[2]);
+    }
+    else
+    {
+        fprintf(stderr, "usage: %s pty [symlink] | unix <path> | tcp <port>\n", argv[0]);
+        return 1;
+    }
+
+    RMComm_Initialize((uint8_t *)version, versionLength, rmIntervalMillis, 0x0000FFFFU);
+    RMComm_AttachRegistry(rmRegistry, sizeof(rmRegistry) / sizeof(rmRegistry[0]));
+
+    if( !RMLinux_Open(&config) || !RMLinux_Start() )
+    {
+        perror("rmLinuxDemo");
+        return 1;
+    }
+
+    printf("testCount is at %p, listening on %s\n", (void*)&testCount,
+           (config.backend == RMLINUX_BACKEND_TCP) ? argv[2] : RMLinux_GetDeviceName());
+
+    while( 1 )
+    {
+        nanosleep(&interval, NULL);
+        testCount++;
+        RMComm_PrintNumber(testCount);
+        RMComm_Println();
+    }
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Sidecar example: follows an RmShm ring and prints every sample in hex.
+//
+// usage: rmShmReader <name>
+// build: cc -O2 -I../rmDemo rmShmReader.c RmShm.c ../rmDemo/RmCore.c ../rmDemo/RmComm.c
+
+#include "RmShm.h"
+
+#include <stdio.h>
+#include <time.h>
+
+int main(int argc, char* argv[])
+{
+    RMShm_Ring ring;
+    uint8_t buffer[RMSHM_DATA_SIZE];
+    uint64_t read_index = 0;
+    uint64_t timestamp;
+    uint64_t lost = 0;
+    uint64_t reported_lost = 0;
+    struct timespec interval = { 0, 1000000 };
+    int length;
+    int index;
+
+    if( argc != 2 )
+    {
+        fprintf(stderr, "usage: %s <name>\n", argv[0]);
+        return 1;
+    }
+
+    if( !RMShm_Attach(&ring, argv[1]) )
+    {
+        perror("rmShmReader");
+        return 1;
+    }
+
+    while( 1 )
+    {
+        length = RMShm_Read(&ring, &read_index, buffer, &timestamp, &lost);
+        if( length == 0 )
+        {
+            nanosleep(&interval, NULL);
+            continue;
+        }
+
+        if( lost != reported_lost )
+        {
+            printf("# lost %llu\n", (unsigned long long)(lost - reported_lost));
+            reported_lost = lost;
+        }
+
+        printf("%llu %llu:", (unsigned long long)(read_index - 1), (unsigned long long)timestamp);
+        for( index = 0; index < length; index++ )
+        {
+            printf(" %02x", buffer[index]);
+        }
+        printf("\n");
+    }
+
+    return 0;
+}
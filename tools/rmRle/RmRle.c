@@ -0,0 +1,159 @@
+//******************************************************************************
+// RmRle(Decoder of run-length compressed dumps)
+// Copyright 2024 Naoya Imai
+//******************************************************************************
+
+#include "RmRle.h"
+
+#include <string.h>
+
+/**
+ * @fn size_t RMRle_Decode(const uint8_t input[], size_t inputSize, uint8_t output[], size_t outputSize)
+ * @brief Decodes a sequence of tokens.
+ *
+ * @param input Tokens without the consumed header.
+ * @param inputSize Size of input.
+ * @param output Array receiving the decoded bytes.
+ * @param outputSize Size of output.
+ * @return The number of decoded bytes, RMRLE_ERROR if a token is truncated or output is too small.
+ */
+size_t RMRle_Decode( const uint8_t input[], size_t inputSize, uint8_t output[], size_t outputSize )
+{
+    size_t input_index;
+    size_t output_index;
+    size_t count;
+    uint8_t control;
+
+    input_index = 0;
+    output_index = 0;
+
+    while( input_index < inputSize )
+    {
+        control = input[input_index++];
+
+        if( control < RMRLE_LITERAL_MAX )
+        {
+            count = (size_t)control + 1;
+            if( (inputSize - input_index) < count || (outputSize - output_index) < count )
+            {
+                return RMRLE_ERROR;
+            }
+
+            memcpy(&output[output_index], &input[input_index], count);
+            input_index += count;
+        }
+        else
+        {
+            if( control == RMRLE_LONG_REPEAT )
+            {
+                if( (inputSize - input_index) < 3 )
+                {
+                    return RMRLE_ERROR;
+                }
+
+                count  = (size_t)input[input_index];
+                count |= (size_t)input[input_index + 1] << 8;
+                input_index += 2;
+            }
+            else
+            {
+                if( (inputSize - input_index) < 1 )
+                {
+                    return RMRLE_ERROR;
+                }
+
+                count = (size_t)(control - RMRLE_REPEAT) + RMRLE_REPEAT_MIN;
+            }
+
+            if( (outputSize - output_index) < count )
+            {
+                return RMRLE_ERROR;
+            }
+
+            memset(&output[output_index], input[input_index], count);
+            input_index++;
+        }
+
+        output_index += count;
+    }
+
+    return output_index;
+}
+
+/**
+ * @fn size_t RMRle_DecodeResponse(const uint8_t payload[], size_t payloadSize, uint8_t output[], size_t outputSize, size_t* pUsed)
+ * @brief Decodes the first response payload of a buffer holding one or more of them back to back.
+ *
+ * The consumed header tells where the tokens of the response end, so responses saved one after
+ * another need no other framing.
+ *
+ * @param payload Response payloads.
+ * @param payloadSize Size of payload.
+ * @param output Array receiving the decoded bytes.
+ * @param outputSize Size of output.
+ * @param pUsed Receives the size of the decoded response payload.
+ * @return The number of decoded bytes, RMRLE_ERROR if the payload is malformed.
+ */
+size_t RMRle_DecodeResponse( const uint8_t payload[], size_t payloadSize, uint8_t output[], size_t outputSize, size_t* pUsed )
+{
+    size_t consumed;
+    size_t input_index;
+    size_t output_index;
+    size_t size;
+    size_t token_size;
+
+    if( payloadSize < RMRLE_HEADER_SIZE )
+    {
+        return RMRLE_ERROR;
+    }
+
+    consumed  = (size_t)payload[0];
+    consumed |= (size_t)payload[1] << 8;
+    if( consumed > outputSize )
+    {
+        return RMRLE_ERROR;
+    }
+
+    /* Decode token by token until the consumed bytes are produced */
+    input_index = RMRLE_HEADER_SIZE;
+    output_index = 0;
+    while( output_index < consumed )
+    {
+        if( input_index >= payloadSize )
+        {
+            return RMRLE_ERROR;
+        }
+
+        if( payload[input_index] < RMRLE_LITERAL_MAX )
+        {
+            token_size = 1 + (size_t)payload[input_index] + 1;
+        }
+        else if( payload[input_index] == RMRLE_LONG_REPEAT )
+        {
+            token_size = 1 + 2 + 1;
+        }
+        else
+        {
+            token_size = 1 + 1;
+        }
+
+        if( (payloadSize - input_index) < token_size )
+        {
+            return RMRLE_ERROR;
+        }
+
+        size = RMRle_Decode(&payload[input_index], token_size, &output[output_index], consumed - output_index);
+        if( size == RMRLE_ERROR )
+        {
+            return RMRLE_ERROR;
+        }
+
+        input_index += token_size;
+        output_index += size;
+    }
+
+    *pUsed = input_index;
+    return output_index;
+}
+
+/*-- end of file --*/
@@ -0,0 +1,31 @@
+#ifndef RM_RLE_H
+#define RM_RLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Decoder of the run-length compressed dumps of RmCore (extended request 0x09, sub-code 0x11).
+ *
+ * A response payload holds the number of bytes consumed(2, little-endian) and tokens:
+ *   0x00-0x7F  control + 1 bytes follow as they are
+ *   0x80-0xFE  the next byte repeated control - 0x80 + 3 times
+ *   0xFF       count(2, little-endian) and a byte repeated count times
+ * Tokens never span responses, and the tokens of a response decode to exactly the consumed bytes.
+ */
+
+#define RMRLE_HEADER_SIZE       2
+#define RMRLE_LITERAL_MAX       0x80
+#define RMRLE_REPEAT            0x80
+#define RMRLE_REPEAT_MIN        3
+#define RMRLE_LONG_REPEAT       0xFF
+
+#define RMRLE_ERROR             SIZE_MAX
+
+size_t RMRle_Decode( const uint8_t input[], size_t inputSize, uint8_t output[], size_t outputSize );
+size_t RMRle_DecodeResponse( const uint8_t payload[], size_t payloadSize, uint8_t output[], size_t outputSize, size_t* pUsed );
+
+#endif  /* RM_RLE_H */
+
+/*-- end of file --*/
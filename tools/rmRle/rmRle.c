@@ -0,0 +1,175 @@
+// Host tool that decodes run-length compressed dumps of RmCore.
+//
+// usage: rmRle [-v] <responses> [out]
+//
+//   <responses>  response payloads of sub-code 0x11 saved back to back, "-" for stdin
+//   out          decoded memory, stdout by default
+//   -v           print the compression ratio to stderr
+
+#include "RmRle.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*-- begin: prototype of function --*/
+
+static uint8_t* RMRle_ReadAll( FILE* file, size_t* pSize );
+
+/*-- begin: functions --*/
+
+int main(int argc, char* argv[])
+{
+    FILE* input;
+    FILE* output;
+    uint8_t* payload;
+    uint8_t* decoded;
+    size_t payload_size;
+    size_t payload_index;
+    size_t decoded_size;
+    size_t decoded_capacity;
+    size_t size;
+    size_t used;
+    size_t responses;
+    bool isVerbose = false;
+    int option;
+
+    while( (option = getopt(argc, argv, "v")) != -1 )
+    {
+        switch( option )
+        {
+        case 'v':
+            isVerbose = true;
+            break;
+        default:
+            argc = 0;
+            break;
+        }
+    }
+
+    if( (argc - optind) < 1 )
+    {
+        fprintf(stderr, "usage: rmRle [-v] <responses> [out]\n");
+        return 1;
+    }
+
+    input = (strcmp(argv[optind], "-") == 0) ? stdin : fopen(argv[optind], "rb");
+    if( input == NULL )
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    payload = RMRle_ReadAll(input, &payload_size);
+    if( input != stdin )
+    {
+        fclose(input);
+    }
+
+    if( payload == NULL )
+    {
+        fprintf(stderr, "rmRle: cannot read %s\n", argv[optind]);
+        return 1;
+    }
+
+    /* A response decodes to at most 0xFFFF bytes */
+    decoded_capacity = 0;
+    decoded_size = 0;
+    decoded = NULL;
+    payload_index = 0;
+    responses = 0;
+
+    while( payload_index < payload_size )
+    {
+        if( (decoded_capacity - decoded_size) < 0xFFFF )
+        {
+            decoded_capacity = decoded_capacity * 2 + 0xFFFF;
+            decoded = realloc(decoded, decoded_capacity);
+            if( decoded == NULL )
+            {
+                fprintf(stderr, "rmRle: out of memory\n");
+                return 1;
+            }
+        }
+
+        size = RMRle_DecodeResponse(&payload[payload_index], payload_size - payload_index,
+                                    &decoded[decoded_size], decoded_capacity - decoded_size, &used);
+        if( size == RMRLE_ERROR )
+        {
+            fprintf(stderr, "rmRle: malformed response at offset %zu\n", payload_index);
+            return 1;
+        }
+
+        payload_index += used;
+        decoded_size += size;
+        responses++;
+    }
+
+    output = ((argc - optind) >= 2) ? fopen(argv[optind + 1], "wb") : stdout;
+    if( output == NULL )
+    {
+        perror(argv[optind + 1]);
+        return 1;
+    }
+
+    if( decoded_size > 0 && fwrite(decoded, 1, decoded_size, output) != decoded_size )
+    {
+        fprintf(stderr, "rmRle: cannot write the output\n");
+        return 1;
+    }
+
+    if( output != stdout )
+    {
+        fclose(output);
+    }
+
+    if( isVerbose )
+    {
+        fprintf(stderr, "rmRle: %zu responses, %zu bytes decoded to %zu bytes\n", responses, payload_size, decoded_size);
+    }
+
+    free(payload);
+    free(decoded);
+    return 0;
+}
+
+/**
+ * @fn uint8_t* RMRle_ReadAll(FILE* file, size_t* pSize)
+ * @brief Reads a whole file into a buffer allocated with malloc().
+ */
+static uint8_t* RMRle_ReadAll( FILE* file, size_t* pSize )
+{
+    uint8_t* buffer;
+    size_t capacity;
+    size_t size;
+    size_t count;
+
+    capacity = 4096;
+    size = 0;
+    buffer = malloc(capacity);
+
+    while( buffer != NULL )
+    {
+        count = fread(&buffer[size], 1, capacity - size, file);
+        size += count;
+        if( size < capacity )
+        {
+            break;
+        }
+
+        capacity *= 2;
+        buffer = realloc(buffer, capacity);
+    }
+
+    if( buffer == NULL || ferror(file) )
+    {
+        free(buffer);
+        return NULL;
+    }
+
+    *pSize = size;
+    return buffer;
+}
+
+/*-- end of file --*/
@@ -0,0 +1,2024 @@
+//******************************************************************************
+// RmSymIndex(ELF/DWARF symbol index for RM Classic view files)
+// Copyright 2024 Naoya Imai
+//******************************************************************************
+
+#include "RmSymIndex.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define RMSYM_NONE              UINT32_MAX
+#define RMSYM_NO_OFFSET         UINT64_MAX
+#define RMSYM_EXPAND_DEPTH      8
+#define RMSYM_TREE_DEPTH        64
+#define RMSYM_CACHE_FLAG_RELOCATABLE 0x01
+
+/* Definitions of ELF */
+#define RMSYM_ET_DYN            3
+#define RMSYM_SHT_SYMTAB        2
+#define RMSYM_SHF_COMPRESSED    0x800
+#define RMSYM_STT_OBJECT        1
+#define RMSYM_SHN_UNDEF         0
+
+/* Definitions of DWARF tags */
+#define RMSYM_TAG_ARRAY         0x01
+#define RMSYM_TAG_CLASS         0x02
+#define RMSYM_TAG_ENUMERATION   0x04
+#define RMSYM_TAG_MEMBER        0x0d
+#define RMSYM_TAG_POINTER       0x0f
+#define RMSYM_TAG_REFERENCE     0x10
+#define RMSYM_TAG_STRUCTURE     0x13
+#define RMSYM_TAG_TYPEDEF       0x16
+#define RMSYM_TAG_UNION         0x17
+#define RMSYM_TAG_PTR_TO_MEMBER 0x1f
+#define RMSYM_TAG_SUBRANGE      0x21
+#define RMSYM_TAG_BASE_TYPE     0x24
+#define RMSYM_TAG_CONST         0x26
+#define RMSYM_TAG_SUBPROGRAM    0x2e
+#define RMSYM_TAG_VARIABLE      0x34
+#define RMSYM_TAG_VOLATILE      0x35
+#define RMSYM_TAG_RESTRICT      0x37
+#define RMSYM_TAG_NAMESPACE     0x39
+#define RMSYM_TAG_RVALUE_REF    0x42
+#define RMSYM_TAG_ATOMIC        0x47
+
+/* Definitions of DWARF attributes */
+#define RMSYM_AT_SIBLING        0x01
+#define RMSYM_AT_LOCATION       0x02
+#define RMSYM_AT_NAME           0x03
+#define RMSYM_AT_BYTE_SIZE      0x0b
+#define RMSYM_AT_BIT_SIZE       0x0d
+#define RMSYM_AT_UPPER_BOUND    0x2f
+#define RMSYM_AT_ABSTRACT_ORIGIN 0x31
+#define RMSYM_AT_COUNT          0x37
+#define RMSYM_AT_MEMBER_LOCATION 0x38
+#define RMSYM_AT_DECLARATION    0x3c
+#define RMSYM_AT_ENCODING       0x3e
+#define RMSYM_AT_SPECIFICATION  0x47
+#define RMSYM_AT_TYPE           0x49
+#define RMSYM_AT_DATA_BIT_OFFSET 0x6b
+#define RMSYM_AT_STR_OFFSETS_BASE 0x72
+#define RMSYM_AT_ADDR_BASE      0x73
+#define RMSYM_AT_GNU_ADDR_BASE  0x2133
+
+/* Definitions of DWARF base type encodings */
+#define RMSYM_ATE_ADDRESS       0x01
+#define RMSYM_ATE_BOOLEAN       0x02
+#define RMSYM_ATE_COMPLEX_FLOAT 0x03
+#define RMSYM_ATE_FLOAT         0x04
+#define RMSYM_ATE_SIGNED        0x05
+#define RMSYM_ATE_SIGNED_CHAR   0x06
+
+/* Definitions of DWARF location operations */
+#define RMSYM_OP_ADDR           0x03
+#define RMSYM_OP_PLUS_UCONST    0x23
+#define RMSYM_OP_ADDRX          0xa1
+#define RMSYM_OP_GNU_ADDR_INDEX 0xfb
+
+/* Flags of RMSym_Die */
+#define RMSYM_DIE_HAS_ADDRESS   0x01
+#define RMSYM_DIE_HAS_SIZE      0x02
+#define RMSYM_DIE_HAS_COUNT     0x04
+#define RMSYM_DIE_DECLARATION   0x08
+#define RMSYM_DIE_BITFIELD      0x10
+#define RMSYM_DIE_HAS_OFFSET    0x20
+
+typedef enum
+{
+    RMSYM_CLASS_OTHER = 0,
+    RMSYM_CLASS_CONST,
+    RMSYM_CLASS_ADDRESS,
+    RMSYM_CLASS_ADDRX,
+    RMSYM_CLASS_REFERENCE,
+    RMSYM_CLASS_STRING,
+    RMSYM_CLASS_STRX,
+    RMSYM_CLASS_BLOCK,
+    RMSYM_CLASS_FLAG
+} RMSym_Class;
+
+typedef struct RMSYM_CURSOR
+{
+    const uint8_t* pos;
+    const uint8_t* end;
+    bool isBigEndian;
+    bool isError;
+} RMSym_Cursor;
+
+typedef struct RMSYM_POOL
+{
+    char* data;
+    uint32_t size;
+    uint32_t capacity;
+} RMSym_Pool;
+
+typedef struct RMSYM_SECTION
+{
+    const uint8_t* data;
+    uint64_t size;
+} RMSym_Section;
+
+typedef struct RMSYM_ELF
+{
+    const uint8_t* image;
+    uint64_t size;
+    bool is64;
+    bool isBigEndian;
+    bool isRelocatable;
+    RMSym_Section symtab;
+    RMSym_Section strtab;
+    RMSym_Section info;
+    RMSym_Section abbrev;
+    RMSym_Section str;
+    RMSym_Section lineStr;
+    RMSym_Section strOffsets;
+    RMSym_Section addr;
+} RMSym_Elf;
+
+typedef struct RMSYM_ATTRSPEC
+{
+    uint16_t attr;
+    uint16_t form;
+    int64_t implicitConst;
+} RMSym_AttrSpec;
+
+typedef struct RMSYM_ABBREV
+{
+    uint64_t code;
+    uint16_t tag;
+    bool hasChildren;
+    uint32_t specIndex;
+    uint32_t specCount;
+} RMSym_Abbrev;
+
+typedef struct RMSYM_UNIT
+{
+    uint64_t offset;            // start of the unit in .debug_info
+    uint16_t version;
+    uint8_t addressSize;
+    uint8_t offsetSize;
+    uint64_t strOffsetsBase;
+    uint64_t addrBase;
+} RMSym_Unit;
+
+typedef struct RMSYM_VALUE
+{
+    uint16_t attr;
+    uint16_t form;
+    uint8_t cls;                // RMSym_Class
+    uint64_t data;
+    const uint8_t* block;
+    uint64_t length;
+} RMSym_Value;
+
+typedef struct RMSYM_DIE
+{
+    uint64_t offset;            // in .debug_info, records are sorted by it
+    uint64_t typeOffset;
+    uint64_t specOffset;        // DW_AT_specification or DW_AT_abstract_origin
+    uint64_t address;
+    uint64_t byteSize;
+    uint64_t memberOffset;
+    uint64_t count;
+    uint32_t name;              // into RMSym_Dwarf.names, qualified for variables
+    uint32_t firstChild;
+    uint32_t nextSibling;
+    uint16_t tag;
+    uint8_t encoding;
+    uint8_t flags;
+} RMSym_Die;
+
+typedef struct RMSYM_DWARF
+{
+    RMSym_Die* dies;
+    uint32_t count;
+    uint32_t capacity;
+    RMSym_Pool names;
+    RMSym_Abbrev* abbrevs;
+    uint32_t abbrevCount;
+    uint32_t abbrevCapacity;
+    RMSym_AttrSpec* specs;
+    uint32_t specCount;
+    uint32_t specCapacity;
+    uint64_t abbrevOffset;
+} RMSym_Dwarf;
+
+typedef struct RMSYM_BUILDER
+{
+    RMSym_Entry* entries;
+    uint32_t count;
+    uint32_t capacity;
+    RMSym_Pool names;
+    uint32_t arrayLimit;
+} RMSym_Builder;
+
+typedef struct RMSYM_CACHE_HEADER
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entrySize;
+    uint64_t elfSize;
+    uint64_t elfTime;
+    uint32_t arrayLimit;
+    uint32_t count;
+    uint32_t namesSize;
+    uint32_t flags;             // RMSYM_CACHE_FLAG_xxx
+} RMSym_CacheHeader;
+
+/*-- begin: prototype of function --*/
+
+uint64_t RMSym_ReadUnsigned( RMSym_Cursor* pCursor, uint32_t size );
+uint64_t RMSym_ReadULEB( RMSym_Cursor* pCursor );
+int64_t  RMSym_ReadSLEB( RMSym_Cursor* pCursor );
+void     RMSym_Skip( RMSym_Cursor* pCursor, uint64_t size );
+bool     RMSym_Grow( void** pArray, uint32_t* pCapacity, uint32_t count, size_t elementSize );
+uint32_t RMSym_PoolAdd( RMSym_Pool* pPool, const char* text );
+
+bool RMSym_OpenElf( RMSym_Elf* pElf );
+void RMSym_ReadSymtab( RMSym_Elf* pElf, RMSym_Builder* pBuilder );
+bool RMSym_AddEntry( RMSym_Builder* pBuilder, const char* name, uint64_t address, uint64_t size, uint8_t kind );
+
+bool RMSym_ReadDwarf( RMSym_Elf* pElf, RMSym_Dwarf* pDwarf );
+bool RMSym_ReadAbbrevs( RMSym_Elf* pElf, RMSym_Dwarf* pDwarf, uint64_t offset );
+const RMSym_Abbrev* RMSym_FindAbbrev( RMSym_Dwarf* pDwarf, uint64_t code );
+bool RMSym_ReadUnit( RMSym_Elf* pElf, RMSym_Dwarf* pDwarf, RMSym_Cursor* pCursor, RMSym_Unit* pUnit );
+bool RMSym_ReadForm( RMSym_Cursor* pCursor, const RMSym_Unit* pUnit, uint16_t form, int64_t implicitConst, RMSym_Value* pValue );
+const char* RMSym_GetString( RMSym_Elf* pElf, const RMSym_Unit* pUnit, const RMSym_Value* pValue );
+bool RMSym_GetLocation( RMSym_Elf* pElf, const RMSym_Unit* pUnit, const RMSym_Value* pValue, uint64_t* pAddress );
+bool RMSym_IsStoredTag( uint16_t tag );
+
+uint32_t RMSym_FindDie( const RMSym_Dwarf* pDwarf, uint64_t offset );
+uint32_t RMSym_StripType( const RMSym_Dwarf* pDwarf, uint64_t offset );
+uint64_t RMSym_GetTypeSize( const RMSym_Dwarf* pDwarf, uint32_t index );
+uint8_t  RMSym_GetKind( const RMSym_Die* pDie );
+void RMSym_AddVariables( RMSym_Dwarf* pDwarf, RMSym_Builder* pBuilder );
+void RMSym_Expand( RMSym_Dwarf* pDwarf, RMSym_Builder* pBuilder, char name[], size_t length, uint64_t address, uint64_t typeOffset, int depth, bool isSelf );
+void RMSym_ExpandArray( RMSym_Dwarf* pDwarf, RMSym_Builder* pBuilder, char name[], size_t length, uint64_t address, uint32_t array, uint32_t subrange, int depth );
+
+void RMSym_Finish( RMSym_Builder* pBuilder, RMSym_Index* pIndex );
+int  RMSym_CompareEntry( const void* pLeft, const void* pRight );
+bool RMSym_ReadCache( RMSym_Index* pIndex, const char* cachePath, const struct stat* pInfo, uint32_t arrayLimit );
+void RMSym_WriteCache( const RMSym_Index* pIndex, const char* cachePath, const struct stat* pInfo, uint32_t arrayLimit );
+
+/*-- begin: static variables --*/
+static const char* rmSymSortNames;
+
+/*-- begin: functions --*/
+
+/**
+ * @fn bool RMSym_Load(RMSym_Index* pIndex, const char* elfPath, const char* cachePath, uint32_t arrayLimit)
+ * @brief Builds the index of an ELF image, or reads it from the cache.
+ *
+ * @param pIndex Pointer to the index to fill.
+ * @param elfPath Path of the ELF image.
+ * @param cachePath Path of the index cache, or NULL to always parse the image.
+ * @param arrayLimit Arrays with up to this many elements are expanded as "var[i]".
+ * @return True if the index is built, false otherwise.
+ */
+bool RMSym_Load( RMSym_Index* pIndex, const char* elfPath, const char* cachePath, uint32_t arrayLimit )
+{
+    RMSym_Elf elf;
+    RMSym_Dwarf dwarf;
+    RMSym_Builder builder;
+    struct stat info;
+    void* map;
+    int fd;
+
+    memset(pIndex, 0, sizeof(*pIndex));
+
+    fd = open(elfPath, O_RDONLY | O_CLOEXEC);
+    if( fd < 0 || fstat(fd, &info) != 0 )
+    {
+        perror(elfPath);
+        if( fd >= 0 )
+        {
+            close(fd);
+        }
+        return false;
+    }
+
+    if( cachePath != NULL && RMSym_ReadCache(pIndex, cachePath, &info, arrayLimit) )
+    {
+        close(fd);
+        return true;
+    }
+
+    map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if( map == MAP_FAILED )
+    {
+        perror(elfPath);
+        return false;
+    }
+
+    memset(&elf, 0, sizeof(elf));
+    elf.image = (const uint8_t*)map;
+    elf.size = (uint64_t)info.st_size;
+    if( !RMSym_OpenElf(&elf) )
+    {
+        fprintf(stderr, "%s: not a supported ELF image\n", elfPath);
+        munmap(map, (size_t)info.st_size);
+        return false;
+    }
+
+    memset(&builder, 0, sizeof(builder));
+    builder.arrayLimit = arrayLimit;
+
+    /* DWARF goes first, so its typed entries win over the symbol table */
+    memset(&dwarf, 0, sizeof(dwarf));
+    if( RMSym_ReadDwarf(&elf, &dwarf) )
+    {
+        RMSym_AddVariables(&dwarf, &builder);
+    }
+    free(dwarf.dies);
+    free(dwarf.names.data);
+    free(dwarf.abbrevs);
+    free(dwarf.specs);
+
+    RMSym_ReadSymtab(&elf, &builder);
+    munmap(map, (size_t)info.st_size);
+
+    RMSym_Finish(&builder, pIndex);
+    pIndex->isRelocatable = elf.isRelocatable;
+
+    if( cachePath != NULL )
+    {
+        RMSym_WriteCache(pIndex, cachePath, &info, arrayLimit);
+    }
+
+    return true;
+}
+
+/**
+ * @fn void RMSym_Free(RMSym_Index* pIndex)
+ * @brief Releases the index.
+ */
+void RMSym_Free( RMSym_Index* pIndex )
+{
+    free(pIndex->entries);
+    free(pIndex->names);
+    memset(pIndex, 0, sizeof(*pIndex));
+}
+
+/**
+ * @fn void RMSym_Relocate(RMSym_Index* pIndex, uint64_t bias)
+ * @brief Adds the load address of a position-independent image to every entry.
+ */
+void RMSym_Relocate( RMSym_Index* pIndex, uint64_t bias )
+{
+    uint32_t index;
+
+    for( index = 0; index < pIndex->count; index++ )
+    {
+        pIndex->entries[index].address += bias;
+    }
+}
+
+/**
+ * @fn const RMSym_Entry* RMSym_Find(const RMSym_Index* pIndex, const char* name)
+ * @brief Looks up a symbol by its exact name, such as "config.gain[2]".
+ *
+ * @return Pointer to the entry, or NULL if not found.
+ */
+const RMSym_Entry* RMSym_Find( const RMSym_Index* pIndex, const char* name )
+{
+    uint32_t count;
+    const RMSym_Entry* entry;
+
+    entry = RMSym_FindPrefix(pIndex, name, &count);
+    if( entry != NULL && strcmp(RMSym_GetName(pIndex, entry), name) == 0 )
+    {
+        return entry;
+    }
+
+    return NULL;
+}
+
+/**
+ * @fn const RMSym_Entry* RMSym_FindPrefix(const RMSym_Index* pIndex, const char* prefix, uint32_t* pCount)
+ * @brief Finds the sorted run of symbols that start with prefix.
+ *
+ * @param pCount Pointer to store the number of entries in the run.
+ * @return Pointer to the first entry, or NULL if none.
+ */
+const RMSym_Entry* RMSym_FindPrefix( const RMSym_Index* pIndex, const char* prefix, uint32_t* pCount )
+{
+    size_t length = strlen(prefix);
+    uint32_t low = 0;
+    uint32_t high = pIndex->count;
+    uint32_t middle;
+    uint32_t end;
+
+    while( low < high )
+    {
+        middle = low + (high - low) / 2;
+        if( strcmp(pIndex->names + pIndex->entries[middle].nameOffset, prefix) < 0 )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    end = low;
+    while( end < pIndex->count &&
+           strncmp(pIndex->names + pIndex->entries[end].nameOffset, prefix, length) == 0 )
+    {
+        end++;
+    }
+
+    *pCount = end - low;
+    return (end > low) ? &pIndex->entries[low] : NULL;
+}
+
+/**
+ * @fn const char* RMSym_GetName(const RMSym_Index* pIndex, const RMSym_Entry* pEntry)
+ * @brief Returns the name of an entry.
+ */
+const char* RMSym_GetName( const RMSym_Index* pIndex, const RMSym_Entry* pEntry )
+{
+    return pIndex->names + pEntry->nameOffset;
+}
+
+/*-- begin: helpers --*/
+
+uint64_t RMSym_ReadUnsigned( RMSym_Cursor* pCursor, uint32_t size )
+{
+    uint64_t value = 0;
+    uint32_t index;
+
+    if( size > 8 || (uint64_t)(pCursor->end - pCursor->pos) < size )
+    {
+        pCursor->pos = pCursor->end;
+        pCursor->isError = true;
+        return 0;
+    }
+
+    for( index = 0; index < size; index++ )
+    {
+        if( pCursor->isBigEndian )
+        {
+            value = (value << 8) | pCursor->pos[index];
+        }
+        else
+        {
+            value |= (uint64_t)pCursor->pos[index] << (8 * index);
+        }
+    }
+
+    pCursor->pos += size;
+    return value;
+}
+
+uint64_t RMSym_ReadULEB( RMSym_Cursor* pCursor )
+{
+    uint64_t value = 0;
+    uint32_t shift = 0;
+    uint8_t byte;
+
+    do
+    {
+        if( pCursor->pos >= pCursor->end )
+        {
+            pCursor->isError = true;
+            return 0;
+        }
+
+        byte = *pCursor->pos++;
+        if( shift < 64 )
+        {
+            value |= (uint64_t)(byte & 0x7F) << shift;
+        }
+        shift += 7;
+    } while( (byte & 0x80) != 0 );
+
+    return value;
+}
+
+int64_t RMSym_ReadSLEB( RMSym_Cursor* pCursor )
+{
+    uint64_t value = 0;
+    uint32_t shift = 0;
+    uint8_t byte;
+
+    do
+    {
+        if( pCursor->pos >= pCursor->end )
+        {
+            pCursor->isError = true;
+            return 0;
+        }
+
+        byte = *pCursor->pos++;
+        if( shift < 64 )
+        {
+            value |= (uint64_t)(byte & 0x7F) << shift;
+        }
+        shift += 7;
+    } while( (byte & 0x80) != 0 );
+
+    if( shift < 64 && (byte & 0x40) != 0 )
+    {
+        value |= ~(uint64_t)0 << shift;
+    }
+
+    return (int64_t)value;
+}
+
+void RMSym_Skip( RMSym_Cursor* pCursor, uint64_t size )
+{
+    if( (uint64_t)(pCursor->end - pCursor->pos) < size )
+    {
+        pCursor->pos = pCursor->end;
+        pCursor->isError = true;
+        return;
+    }
+
+    pCursor->pos += size;
+}
+
+bool RMSym_Grow( void** pArray, uint32_t* pCapacity, uint32_t count, size_t elementSize )
+{
+    uint32_t capacity;
+    void* array;
+
+    if( count < *pCapacity )
+    {
+        return true;
+    }
+
+    capacity = (*pCapacity == 0) ? 256 : (*pCapacity * 2);
+    array = realloc(*pArray, (size_t)capacity * elementSize);
+    if( array == NULL )
+    {
+        return false;
+    }
+
+    *pArray = array;
+    *pCapacity = capacity;
+    return true;
+}
+
+uint32_t RMSym_PoolAdd( RMSym_Pool* pPool, const char* text )
+{
+    uint32_t length = (uint32_t)strlen(text) + 1;
+    uint32_t offset;
+    char* data;
+
+    while( (pPool->size + length) > pPool->capacity )
+    {
+        pPool->capacity = (pPool->capacity == 0) ? 4096 : (pPool->capacity * 2);
+        data = realloc(pPool->data, pPool->capacity);
+        if( data == NULL )
+        {
+            return RMSYM_NONE;
+        }
+        pPool->data = data;
+    }
+
+    offset = pPool->size;
+    memcpy(pPool->data + offset, text, length);
+    pPool->size += length;
+
+    return offset;
+}
+
+/*-- begin: ELF --*/
+
+bool RMSym_OpenElf( RMSym_Elf* pElf )
+{
+    static const uint8_t magic[4] = { 0x7F, 'E', 'L', 'F' };
+    RMSym_Cursor cursor;
+    uint64_t sectionOffset;
+    uint32_t entrySize;
+    uint32_t sectionCount;
+    uint32_t nameIndex;
+    uint64_t namesOffset = 0;
+    uint64_t namesSize = 0;
+    uint32_t index;
+    int pass;
+
+    if( pElf->size < 64 || memcmp(pElf->image, magic, sizeof(magic)) != 0 ||
+        (pElf->image[4] != 1 && pElf->image[4] != 2) ||
+        (pElf->image[5] != 1 && pElf->image[5] != 2) )
+    {
+        return false;
+    }
+
+    pElf->is64 = (pElf->image[4] == 2);
+    pElf->isBigEndian = (pElf->image[5] == 2);
+
+    cursor.end = pElf->image + pElf->size;
+    cursor.isBigEndian = pElf->isBigEndian;
+    cursor.isError = false;
+
+    cursor.pos = pElf->image + 0x10;
+    pElf->isRelocatable = (RMSym_ReadUnsigned(&cursor, 2) == RMSYM_ET_DYN);
+
+    cursor.pos = pElf->image + (pElf->is64 ? 0x28 : 0x20);
+    sectionOffset = RMSym_ReadUnsigned(&cursor, pElf->is64 ? 8 : 4);
+    cursor.pos = pElf->image + (pElf->is64 ? 0x3A : 0x2E);
+    entrySize = (uint32_t)RMSym_ReadUnsigned(&cursor, 2);
+    sectionCount = (uint32_t)RMSym_ReadUnsigned(&cursor, 2);
+    nameIndex = (uint32_t)RMSym_ReadUnsigned(&cursor, 2);
+
+    if( sectionOffset == 0 || entrySize < (pElf->is64 ? 64U : 40U) ||
+        sectionOffset > pElf->size || (uint64_t)entrySize * sectionCount > pElf->size - sectionOffset ||
+        nameIndex >= sectionCount )
+    {
+        return false;
+    }
+
+    /* pass 0 finds the section names, pass 1 picks the sections */
+    for( pass = 0; pass < 2; pass++ )
+    {
+        for( index = (pass == 0) ? nameIndex : 0; index < sectionCount; index++ )
+        {
+            uint32_t name;
+            uint32_t type;
+            uint64_t flags;
+            uint64_t offset;
+            uint64_t size;
+            uint32_t link;
+            RMSym_Section section;
+            const char* text;
+
+            cursor.pos = pElf->image + sectionOffset + (uint64_t)index * entrySize;
+            name = (uint32_t)RMSym_ReadUnsigned(&cursor, 4);
+            type = (uint32_t)RMSym_ReadUnsigned(&cursor, 4);
+            flags = RMSym_ReadUnsigned(&cursor, pElf->is64 ? 8 : 4);
+            RMSym_Skip(&cursor, pElf->is64 ? 8 : 4);
+            offset = RMSym_ReadUnsigned(&cursor, pElf->is64 ? 8 : 4);
+            size = RMSym_ReadUnsigned(&cursor, pElf->is64 ? 8 : 4);
+            link = (uint32_t)RMSym_ReadUnsigned(&cursor, 4);
+
+            if( offset > pElf->size || size > pElf->size - offset )
+            {
+                if( pass == 0 )
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            if( pass == 0 )
+            {
+                namesOffset = offset;
+                namesSize = size;
+                break;
+            }
+
+            if( name >= namesSize || memchr(pElf->image + namesOffset + name, 0, namesSize - name) == NULL )
+            {
+                continue;
+            }
+
+            section.data = pElf->image + offset;
+            section.size = size;
+            text = (const char*)(pElf->image + namesOffset + name);
+
+            if( type == RMSYM_SHT_SYMTAB && link < sectionCount )
+            {
+                RMSym_Cursor linked = cursor;
+
+                pElf->symtab = section;
+                linked.pos = pElf->image + sectionOffset + (uint64_t)link * entrySize + (pElf->is64 ? 24 : 16);
+                offset = RMSym_ReadUnsigned(&linked, pElf->is64 ? 8 : 4);
+                size = RMSym_ReadUnsigned(&linked, pElf->is64 ? 8 : 4);
+                if( offset <= pElf->size && size <= pElf->size - offset )
+                {
+                    pElf->strtab.data = pElf->image + offset;
+                    pElf->strtab.size = size;
+                }
+                continue;
+            }
+
+            if( strncmp(text, ".debug_", 7) != 0 )
+            {
+                continue;
+            }
+
+            if( (flags & RMSYM_SHF_COMPRESSED) != 0 )
+            {
+                fprintf(stderr, "rmSym: %s is compressed, relink with --compress-debug-sections=none\n", text);
+                continue;
+            }
+
+            if( strcmp(text, ".debug_info") == 0 )              pElf->info = section;
+            else if( strcmp(text, ".debug_abbrev") == 0 )       pElf->abbrev = section;
+            else if( strcmp(text, ".debug_str") == 0 )          pElf->str = section;
+            else if( strcmp(text, ".debug_line_str") == 0 )     pElf->lineStr = section;
+            else if( strcmp(text, ".debug_str_offsets") == 0 )  pElf->strOffsets = section;
+            else if( strcmp(text, ".debug_addr") == 0 )         pElf->addr = section;
+        }
+    }
+
+    return !cursor.isError;
+}
+
+void RMSym_ReadSymtab( RMSym_Elf* pElf, RMSym_Builder* pBuilder )
+{
+    RMSym_Cursor cursor;
+    uint32_t symbolSize = pElf->is64 ? 24 : 16;
+    uint64_t count = pElf->symtab.size / symbolSize;
+    uint64_t index;
+
+    if( pElf->symtab.data == NULL || pElf->strtab.data == NULL )
+    {
+        return;
+    }
+
+    cursor.end = pElf->symtab.data + pElf->symtab.size;
+    cursor.isBigEndian = pElf->isBigEndian;
+    cursor.isError = false;
+
+    for( index = 1; index < count; index++ )
+    {
+        uint32_t name;
+        uint8_t type;
+        uint16_t section;
+        uint64_t value;
+        uint64_t size;
+
+        cursor.pos = pElf->symtab.data + index * symbolSize;
+        name = (uint32_t)RMSym_ReadUnsigned(&cursor, 4);
+        if( pElf->is64 )
+        {
+            type = (uint8_t)RMSym_ReadUnsigned(&cursor, 1) & 0x0F;
+            RMSym_Skip(&cursor, 1);
+            section = (uint16_t)RMSym_ReadUnsigned(&cursor, 2);
+            value = RMSym_ReadUnsigned(&cursor, 8);
+            size = RMSym_ReadUnsigned(&cursor, 8);
+        }
+        else
+        {
+            value = RMSym_ReadUnsigned(&cursor, 4);
+            size = RMSym_ReadUnsigned(&cursor, 4);
+            type = (uint8_t)RMSym_ReadUnsigned(&cursor, 1) & 0x0F;
+            RMSym_Skip(&cursor, 1);
+            section = (uint16_t)RMSym_ReadUnsigned(&cursor, 2);
+        }
+
+        if( type != RMSYM_STT_OBJECT || section == RMSYM_SHN_UNDEF || size == 0 ||
+            name >= pElf->strtab.size || pElf->strtab.data[name] == '\0' ||
+            memchr(pElf->strtab.data + name, 0, pElf->strtab.size - name) == NULL )
+        {
+            continue;
+        }
+
+        RMSym_AddEntry(pBuilder, (const char*)pElf->strtab.data + name, value, size, RMSYM_KIND_UNKNOWN);
+    }
+}
+
+bool RMSym_AddEntry( RMSym_Builder* pBuilder, const char* name, uint64_t address, uint64_t size, uint8_t kind )
+{
+    RMSym_Entry* entry;
+    uint32_t offset;
+
+    if( !RMSym_Grow((void**)&pBuilder->entries, &pBuilder->capacity, pBuilder->count, sizeof(RMSym_Entry)) )
+    {
+        return false;
+    }
+
+    offset = RMSym_PoolAdd(&pBuilder->names, name);
+    if( offset == RMSYM_NONE )
+    {
+        return false;
+    }
+
+    entry = &pBuilder->entries[pBuilder->count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->address = address;
+    entry->size = (size > UINT32_MAX) ? UINT32_MAX : (uint32_t)size;
+    entry->nameOffset = offset;
+    entry->kind = kind;
+
+    return true;
+}
+
+/*-- begin: DWARF --*/
+
+bool RMSym_ReadDwarf( RMSym_Elf* pElf, RMSym_Dwarf* pDwarf )
+{
+    RMSym_Cursor cursor;
+    RMSym_Unit unit;
+    uint64_t length;
+    const uint8_t* next;
+
+    if( pElf->info.data == NULL || pElf->abbrev.data == NULL )
+    {
+        return false;
+    }
+
+    pDwarf->abbrevOffset = RMSYM_NO_OFFSET;
+
+    cursor.pos = pElf->info.data;
+    cursor.end = pElf->info.data + pElf->info.size;
+    cursor.isBigEndian = pElf->isBigEndian;
+    cursor.isError = false;
+
+    while( cursor.pos < cursor.end )
+    {
+        memset(&unit, 0, sizeof(unit));
+        unit.offset = (uint64_t)(cursor.pos - pElf->info.data);
+        unit.offsetSize = 4;
+
+        length = RMSym_ReadUnsigned(&cursor, 4);
+        if( length == 0xFFFFFFFFULL )
+        {
+            unit.offsetSize = 8;
+            length = RMSym_ReadUnsigned(&cursor, 8);
+        }
+
+        if( cursor.isError || length > (uint64_t)(cursor.end - cursor.pos) )
+        {
+            break;
+        }
+
+        next = cursor.pos + length;
+        {
+            RMSym_Cursor body = cursor;
+
+            body.end = next;
+            if( !RMSym_ReadUnit(pElf, pDwarf, &body, &unit) )
+            {
+                fprintf(stderr, "rmSym: skipped a DWARF unit at 0x%llx\n", (unsigned long long)unit.offset);
+            }
+        }
+        cursor.pos = next;
+    }
+
+    return (pDwarf->count != 0);
+}
+
+bool RMSym_ReadAbbrevs( RMSym_Elf* pElf, RMSym_Dwarf* pDwarf, uint64_t offset )
+{
+    RMSym_Cursor cursor;
+    RMSym_Abbrev* abbrev;
+    RMSym_AttrSpec* spec;
+    uint64_t code;
+    uint16_t attr;
+    uint16_t form;
+
+    if( offset == pDwarf->abbrevOffset )
+    {
+        return true;
+    }
+
+    if( offset >= pElf->abbrev.size )
+    {
+        return false;
+    }
+
+    pDwarf->abbrevCount = 0;
+    pDwarf->specCount = 0;
+    pDwarf->abbrevOffset = RMSYM_NO_OFFSET;
+
+    cursor.pos = pElf->abbrev.data + offset;
+    cursor.end = pElf->abbrev.data + pElf->abbrev.size;
+    cursor.isBigEndian = pElf->isBigEndian;
+    cursor.isError = false;
+
+    while( (code = RMSym_ReadULEB(&cursor)) != 0 && !cursor.isError )
+    {
+        if( !RMSym_Grow((void**)&pDwarf->abbrevs, &pDwarf->abbrevCapacity, pDwarf->abbrevCount, sizeof(RMSym_Abbrev)) )
+        {
+            return false;
+        }
+
+        abbrev = &pDwarf->abbrevs[pDwarf->abbrevCount++];
+        abbrev->code = code;
+        abbrev->tag = (uint16_t)RMSym_ReadULEB(&cursor);
+        abbrev->hasChildren = (RMSym_ReadUnsigned(&cursor, 1) != 0);
+        abbrev->specIndex = pDwarf->specCount;
+        abbrev->specCount = 0;
+
+        while( !cursor.isError )
+        {
+            attr = (uint16_t)RMSym_ReadULEB(&cursor);
+            form = (uint16_t)RMSym_ReadULEB(&cursor);
+            if( attr == 0 && form == 0 )
+            {
+                break;
+            }
+
+            if( !RMSym_Grow((void**)&pDwarf->specs, &pDwarf->specCapacity, pDwarf->specCount, sizeof(RMSym_AttrSpec)) )
+            {
+                return false;
+            }
+
+            spec = &pDwarf->specs[pDwarf->specCount++];
+            spec->attr = attr;
+            spec->form = form;
+            spec->implicitConst = (form == 0x21) ? RMSym_ReadSLEB(&cursor) : 0;
+            abbrev->specCount++;
+        }
+    }
+
+    if( cursor.isError )
+    {
+        return false;
+    }
+
+    pDwarf->abbrevOffset = offset;
+    return true;
+}
+
+const RMSym_Abbrev* RMSym_FindAbbrev( RMSym_Dwarf* pDwarf, uint64_t code )
+{
+    uint32_t index;
+
+    /* compilers number the codes from 1 in order */
+    if( code >= 1 && code <= pDwarf->abbrevCount && pDwarf->abbrevs[code - 1].code == code )
+    {
+        return &pDwarf->abbrevs[code - 1];
+    }
+
+    for( index = 0; index < pDwarf->abbrevCount; index++ )
+    {
+        if( pDwarf->abbrevs[index].code == code )
+        {
+            return &pDwarf->abbrevs[index];
+        }
+    }
+
+    return NULL;
+}
+
+bool RMSym_ReadUnit( RMSym_Elf* pElf, RMSym_Dwarf* pDwarf, RMSym_Cursor* pCursor, RMSym_Unit* pUnit )
+{
+    uint64_t abbrevOffset;
+    uint8_t unitType = 1;
+    uint32_t dieAtDepth[RMSYM_TREE_DEPTH];
+    uint32_t lastChild[RMSYM_TREE_DEPTH];
+    uint16_t prefixLength[RMSYM_TREE_DEPTH];
+    char prefix[RMSYM_NAME_SIZE];
+    int functionDepth = -1;
+    int depth = 0;
+    RMSym_Value values[64];
+
+    pUnit->version = (uint16_t)RMSym_ReadUnsigned(pCursor, 2);
+    if( pUnit->version < 2 || pUnit->version > 5 )
+    {
+        return false;
+    }
+
+    if( pUnit->version >= 5 )
+    {
+        unitType = (uint8_t)RMSym_ReadUnsigned(pCursor, 1);
+        pUnit->addressSize = (uint8_t)RMSym_ReadUnsigned(pCursor, 1);
+        abbrevOffset = RMSym_ReadUnsigned(pCursor, pUnit->offsetSize);
+        if( unitType == 2 || unitType == 6 )
+        {
+            RMSym_Skip(pCursor, 8 + pUnit->offsetSize);     /* type units */
+        }
+        else if( unitType == 4 || unitType == 5 )
+        {
+            RMSym_Skip(pCursor, 8);                         /* skeleton and split units */
+        }
+    }
+    else
+    {
+        abbrevOffset = RMSym_ReadUnsigned(pCursor, pUnit->offsetSize);
+        pUnit->addressSize = (uint8_t)RMSym_ReadUnsigned(pCursor, 1);
+    }
+
+    if( pCursor->isError || pUnit->addressSize == 0 || pUnit->addressSize > 8 ||
+        !RMSym_ReadAbbrevs(pElf, pDwarf, abbrevOffset) )
+    {
+        return false;
+    }
+
+    /* DWARF 5 defaults when the unit has no base attributes */
+    pUnit->strOffsetsBase = 8;
+    pUnit->addrBase = 8;
+
+    prefix[0] = '\0';
+    prefixLength[0] = 0;
+    dieAtDepth[0] = RMSYM_NONE;
+    lastChild[0] = RMSYM_NONE;
+
+    while( pCursor->pos < pCursor->end )
+    {
+        uint64_t offset = (uint64_t)(pCursor->pos - pElf->info.data);
+        uint64_t code;
+        const RMSym_Abbrev* abbrev;
+        const RMSym_AttrSpec* spec;
+        const char* name = NULL;
+        uint64_t sibling = RMSYM_NO_OFFSET;
+        uint32_t valueCount;
+        uint32_t index;
+        uint32_t record = RMSYM_NONE;
+        RMSym_Die die;
+
+        code = RMSym_ReadULEB(pCursor);
+        if( pCursor->isError )
+        {
+            return false;
+        }
+
+        if( code == 0 )
+        {
+            if( depth == 0 )
+            {
+                continue;       /* padding */
+            }
+
+            depth--;
+            if( functionDepth >= depth )
+            {
+                functionDepth = -1;
+            }
+            prefix[prefixLength[depth]] = '\0';
+            continue;
+        }
+
+        abbrev = RMSym_FindAbbrev(pDwarf, code);
+        if( abbrev == NULL || abbrev->specCount > (sizeof(values) / sizeof(values[0])) )
+        {
+            return false;
+        }
+
+        spec = &pDwarf->specs[abbrev->specIndex];
+        valueCount = abbrev->specCount;
+        for( index = 0; index < valueCount; index++ )
+        {
+            values[index].attr = spec[index].attr;
+            if( !RMSym_ReadForm(pCursor, pUnit, spec[index].form, spec[index].implicitConst, &values[index]) )
+            {
+                return false;
+            }
+        }
+
+        /* The unit DIE holds the bases that its own string and address forms need */
+        if( depth == 0 )
+        {
+            for( index = 0; index < valueCount; index++ )
+            {
+                if( values[index].attr == RMSYM_AT_STR_OFFSETS_BASE )
+                {
+                    pUnit->strOffsetsBase = values[index].data;
+                }
+                else if( values[index].attr == RMSYM_AT_ADDR_BASE || values[index].attr == RMSYM_AT_GNU_ADDR_BASE )
+                {
+                    pUnit->addrBase = values[index].data;
+                }
+            }
+        }
+
+        memset(&die, 0, sizeof(die));
+        die.offset = offset;
+        die.typeOffset = RMSYM_NO_OFFSET;
+        die.specOffset = RMSYM_NO_OFFSET;
+        die.name = RMSYM_NONE;
+        die.firstChild = RMSYM_NONE;
+        die.nextSibling = RMSYM_NONE;
+        die.tag = abbrev->tag;
+
+        for( index = 0; index < valueCount; index++ )
+        {
+            const RMSym_Value* value = &values[index];
+
+            switch( value->attr )
+            {
+            case RMSYM_AT_SIBLING:
+                if( value->cls == RMSYM_CLASS_REFERENCE )
+                {
+                    sibling = value->data;
+                }
+                break;
+
+            case RMSYM_AT_NAME:
+                name = RMSym_GetString(pElf, pUnit, value);
+                break;
+
+            case RMSYM_AT_TYPE:
+                if( value->cls == RMSYM_CLASS_REFERENCE )
+                {
+                    die.typeOffset = value->data;
+                }
+                break;
+
+            case RMSYM_AT_SPECIFICATION:
+            case RMSYM_AT_ABSTRACT_ORIGIN:
+                if( value->cls == RMSYM_CLASS_REFERENCE )
+                {
+                    die.specOffset = value->data;
+                }
+                break;
+
+            case RMSYM_AT_LOCATION:
+                if( RMSym_GetLocation(pElf, pUnit, value, &die.address) )
+                {
+                    die.flags |= RMSYM_DIE_HAS_ADDRESS;
+                }
+                break;
+
+            case RMSYM_AT_BYTE_SIZE:
+                if( value->cls == RMSYM_CLASS_CONST )
+                {
+                    die.byteSize = value->data;
+                    die.flags |= RMSYM_DIE_HAS_SIZE;
+                }
+                break;
+
+            case RMSYM_AT_ENCODING:
+                die.encoding = (uint8_t)value->data;
+                break;
+
+            case RMSYM_AT_MEMBER_LOCATION:
+                if( value->cls == RMSYM_CLASS_CONST )
+                {
+                    die.memberOffset = value->data;
+                    die.flags |= RMSYM_DIE_HAS_OFFSET;
+                }
+                else if( value->cls == RMSYM_CLASS_BLOCK && value->length >= 2 && value->block[0] == RMSYM_OP_PLUS_UCONST )
+                {
+                    RMSym_Cursor expression = { value->block + 1, value->block + value->length, pElf->isBigEndian, false };
+
+                    die.memberOffset = RMSym_ReadULEB(&expression);
+                    if( !expression.isError )
+                    {
+                        die.flags |= RMSYM_DIE_HAS_OFFSET;
+                    }
+                }
+                break;
+
+            case RMSYM_AT_BIT_SIZE:
+            case RMSYM_AT_DATA_BIT_OFFSET:
+                die.flags |= RMSYM_DIE_BITFIELD;
+                break;
+
+            case RMSYM_AT_UPPER_BOUND:
+                if( value->cls == RMSYM_CLASS_CONST && (value->data + 1) != 0 )
+                {
+                    die.count = value->data + 1;
+                    die.flags |= RMSYM_DIE_HAS_COUNT;
+                }
+                break;
+
+            case RMSYM_AT_COUNT:
+                if( value->cls == RMSYM_CLASS_CONST )
+                {
+                    die.count = value->data;
+                    die.flags |= RMSYM_DIE_HAS_COUNT;
+                }
+                break;
+
+            case RMSYM_AT_DECLARATION:
+                if( value->data != 0 )
+                {
+                    die.flags |= RMSYM_DIE_DECLARATION;
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        if( (die.tag == RMSYM_TAG_POINTER || die.tag == RMSYM_TAG_REFERENCE || die.tag == RMSYM_TAG_RVALUE_REF) &&
+            (die.flags & RMSYM_DIE_HAS_SIZE) == 0 )
+        {
+            die.byteSize = pUnit->addressSize;
+            die.flags |= RMSYM_DIE_HAS_SIZE;
+        }
+
+        /* Locals of functions are not monitored, their subtrees are skipped when possible */
+        if( die.tag == RMSYM_TAG_SUBPROGRAM && abbrev->hasChildren && functionDepth < 0 )
+        {
+            if( sibling != RMSYM_NO_OFFSET && sibling > offset &&
+                sibling <= (uint64_t)(pCursor->end - pElf->info.data) )
+            {
+                pCursor->pos = pElf->info.data + sibling;
+                continue;
+            }
+            functionDepth = depth;
+        }
+
+        if( RMSym_IsStoredTag(die.tag) && !(die.tag == RMSYM_TAG_VARIABLE && functionDepth >= 0) )
+        {
+            if( name != NULL )
+            {
+                if( die.tag == RMSYM_TAG_VARIABLE || die.tag == RMSYM_TAG_MEMBER )
+                {
+                    char qualified[RMSYM_NAME_SIZE];
+
+                    /* members only need the qualified name as C++ static member declarations */
+                    if( die.tag == RMSYM_TAG_VARIABLE || (die.flags & RMSYM_DIE_DECLARATION) != 0 )
+                    {
+                        snprintf(qualified, sizeof(qualified), "%s%s", prefix, name);
+                        die.name = RMSym_PoolAdd(&pDwarf->names, qualified);
+                    }
+                    else
+                    {
+                        die.name = RMSym_PoolAdd(&pDwarf->names, name);
+                    }
+                }
+            }
+
+            if( !RMSym_Grow((void**)&pDwarf->dies, &pDwarf->capacity, pDwarf->count, sizeof(RMSym_Die)) )
+            {
+                return false;
+            }
+
+            record = pDwarf->count++;
+            pDwarf->dies[record] = die;
+
+            if( depth > 0 && dieAtDepth[depth - 1] != RMSYM_NONE )
+            {
+                if( lastChild[depth] == RMSYM_NONE )
+                {
+                    pDwarf->dies[dieAtDepth[depth - 1]].firstChild = record;
+                }
+                else
+                {
+                    pDwarf->dies[lastChild[depth]].nextSibling = record;
+                }
+                lastChild[depth] = record;
+            }
+        }
+
+        if( abbrev->hasChildren )
+        {
+            if( (depth + 1) >= RMSYM_TREE_DEPTH )
+            {
+                return false;
+            }
+
+            dieAtDepth[depth] = record;
+            depth++;
+            lastChild[depth] = RMSYM_NONE;
+            prefixLength[depth] = prefixLength[depth - 1];
+
+            if( name != NULL &&
+                (die.tag == RMSYM_TAG_NAMESPACE || die.tag == RMSYM_TAG_STRUCTURE ||
+                 die.tag == RMSYM_TAG_CLASS || die.tag == RMSYM_TAG_UNION) )
+            {
+                size_t length = strlen(name);
+
+                if( (prefixLength[depth] + length + 3) <= sizeof(prefix) )
+                {
+                    memcpy(prefix + prefixLength[depth], name, length);
+                    memcpy(prefix + prefixLength[depth] + length, "::", 3);
+                    prefixLength[depth] = (uint16_t)(prefixLength[depth] + length + 2);
+                }
+            }
+        }
+    }
+
+    return !pCursor->isError;
+}
+
+bool RMSym_ReadForm( RMSym_Cursor* pCursor, const RMSym_Unit* pUnit, uint16_t form, int64_t implicitConst, RMSym_Value* pValue )
+{
+    const uint8_t* end;
+
+    pValue->form = form;
+    pValue->cls = RMSYM_CLASS_OTHER;
+    pValue->data = 0;
+    pValue->block = NULL;
+    pValue->length = 0;
+
+    switch( form )
+    {
+    case 0x01:  /* addr */
+        pValue->cls = RMSYM_CLASS_ADDRESS;
+        pValue->data = RMSym_ReadUnsigned(pCursor, pUnit->addressSize);
+        break;
+
+    case 0x0b:  /* data1 */
+    case 0x05:  /* data2 */
+    case 0x06:  /* data4 */
+    case 0x07:  /* data8 */
+        pValue->cls = RMSYM_CLASS_CONST;
+        pValue->data = RMSym_ReadUnsigned(pCursor, (form == 0x0b) ? 1 : (form == 0x05) ? 2 : (form == 0x06) ? 4 : 8);
+        break;
+
+    case 0x0d:  /* sdata */
+        pValue->cls = RMSYM_CLASS_CONST;
+        pValue->data = (uint64_t)RMSym_ReadSLEB(pCursor);
+        break;
+
+    case 0x0f:  /* udata */
+        pValue->cls = RMSYM_CLASS_CONST;
+        pValue->data = RMSym_ReadULEB(pCursor);
+        break;
+
+    case 0x21:  /* implicit_const */
+        pValue->cls = RMSYM_CLASS_CONST;
+        pValue->data = (uint64_t)implicitConst;
+        break;
+
+    case 0x1e:  /* data16 */
+        RMSym_Skip(pCursor, 16);
+        break;
+
+    case 0x0a:  /* block1 */
+    case 0x03:  /* block2 */
+    case 0x04:  /* block4 */
+    case 0x09:  /* block */
+    case 0x18:  /* exprloc */
+        pValue->cls = RMSYM_CLASS_BLOCK;
+        if( form == 0x0a )      pValue->length = RMSym_ReadUnsigned(pCursor, 1);
+        else if( form == 0x03 ) pValue->length = RMSym_ReadUnsigned(pCursor, 2);
+        else if( form == 0x04 ) pValue->length = RMSym_ReadUnsigned(pCursor, 4);
+        else                    pValue->length = RMSym_ReadULEB(pCursor);
+        pValue->block = pCursor->pos;
+        RMSym_Skip(pCursor, pValue->length);
+        break;
+
+    case 0x0c:  /* flag */
+        pValue->cls = RMSYM_CLASS_FLAG;
+        pValue->data = RMSym_ReadUnsigned(pCursor, 1);
+        break;
+
+    case 0x19:  /* flag_present */
+        pValue->cls = RMSYM_CLASS_FLAG;
+        pValue->data = 1;
+        break;
+
+    case 0x08:  /* string */
+        end = memchr(pCursor->pos, 0, (size_t)(pCursor->end - pCursor->pos));
+        if( end == NULL )
+        {
+            pCursor->isError = true;
+            return false;
+        }
+        pValue->cls = RMSYM_CLASS_STRING;
+        pValue->block = pCursor->pos;
+        pCursor->pos = end + 1;
+        break;
+
+    case 0x0e:  /* strp */
+    case 0x1f:  /* line_strp */
+        pValue->cls = RMSYM_CLASS_STRING;
+        pValue->data = RMSym_ReadUnsigned(pCursor, pUnit->offsetSize);
+        pValue->length = (form == 0x1f);      /* 1: .debug_line_str */
+        break;
+
+    case 0x1a:  /* strx */
+    case 0x1f02:/* GNU_str_index */
+        pValue->cls = RMSYM_CLASS_STRX;
+        pValue->data = RMSym_ReadULEB(pCursor);
+        break;
+
+    case 0x25:  /* strx1 */
+    case 0x26:  /* strx2 */
+    case 0x27:  /* strx3 */
+    case 0x28:  /* strx4 */
+        pValue->cls = RMSYM_CLASS_STRX;
+        pValue->data = RMSym_ReadUnsigned(pCursor, (uint32_t)(form - 0x24));
+        break;
+
+    case 0x1b:  /* addrx */
+    case 0x1f01:/* GNU_addr_index */
+        pValue->cls = RMSYM_CLASS_ADDRX;
+        pValue->data = RMSym_ReadULEB(pCursor);
+        break;
+
+    case 0x29:  /* addrx1 */
+    case 0x2a:  /* addrx2 */
+    case 0x2b:  /* addrx3 */
+    case 0x2c:  /* addrx4 */
+        pValue->cls = RMSYM_CLASS_ADDRX;
+        pValue->data = RMSym_ReadUnsigned(pCursor, (uint32_t)(form - 0x28));
+        break;
+
+    case 0x11:  /* ref1 */
+    case 0x12:  /* ref2 */
+    case 0x13:  /* ref4 */
+    case 0x14:  /* ref8 */
+        pValue->cls = RMSYM_CLASS_REFERENCE;
+        pValue->data = pUnit->offset + RMSym_ReadUnsigned(pCursor, (form == 0x11) ? 1 : (form == 0x12) ? 2 : (form == 0x13) ? 4 : 8);
+        break;
+
+    case 0x15:  /* ref_udata */
+        pValue->cls = RMSYM_CLASS_REFERENCE;
+        pValue->data = pUnit->offset + RMSym_ReadULEB(pCursor);
+        break;
+
+    case 0x10:  /* ref_addr */
+        pValue->cls = RMSYM_CLASS_REFERENCE;
+        pValue->data = RMSym_ReadUnsigned(pCursor, (pUnit->version == 2) ? pUnit->addressSize : pUnit->offsetSize);
+        break;
+
+    case 0x17:  /* sec_offset */
+        pValue->cls = RMSYM_CLASS_CONST;
+        pValue->data = RMSym_ReadUnsigned(pCursor, pUnit->offsetSize);
+        break;
+
+    case 0x1d:  /* strp_sup */
+    case 0x1f20:/* GNU_ref_alt */
+    case 0x1f21:/* GNU_strp_alt */
+        RMSym_Skip(pCursor, pUnit->offsetSize);
+        break;
+
+    case 0x1c:  /* ref_sup4 */
+        RMSym_Skip(pCursor, 4);
+        break;
+
+    case 0x20:  /* ref_sig8 */
+    case 0x24:  /* ref_sup8 */
+        RMSym_Skip(pCursor, 8);
+        break;
+
+    case 0x22:  /* loclistx */
+    case 0x23:  /* rnglistx */
+        RMSym_ReadULEB(pCursor);
+        break;
+
+    case 0x16:  /* indirect */
+        form = (uint16_t)RMSym_ReadULEB(pCursor);
+        if( form == 0x16 || pCursor->isError )
+        {
+            return false;
+        }
+        return RMSym_ReadForm(pCursor, pUnit, form, implicitConst, pValue);
+
+    default:
+        pCursor->isError = true;
+        return false;
+    }
+
+    return !pCursor->isError;
+}
+
+const char* RMSym_GetString( RMSym_Elf* pElf, const RMSym_Unit* pUnit, const RMSym_Value* pValue )
+{
+    const RMSym_Section* section = &pElf->str;
+    uint64_t offset;
+
+    if( pValue->cls == RMSYM_CLASS_STRING && pValue->block != NULL )
+    {
+        return (const char*)pValue->block;
+    }
+
+    if( pValue->cls == RMSYM_CLASS_STRING )
+    {
+        section = (pValue->length != 0) ? &pElf->lineStr : &pElf->str;
+        offset = pValue->data;
+    }
+    else if( pValue->cls == RMSYM_CLASS_STRX )
+    {
+        RMSym_Cursor cursor;
+        uint64_t position = pUnit->strOffsetsBase + pValue->data * pUnit->offsetSize;
+
+        if( pElf->strOffsets.data == NULL || position >= pElf->strOffsets.size )
+        {
+            return NULL;
+        }
+
+        cursor.pos = pElf->strOffsets.data + position;
+        cursor.end = pElf->strOffsets.data + pElf->strOffsets.size;
+        cursor.isBigEndian = pElf->isBigEndian;
+        cursor.isError = false;
+        offset = RMSym_ReadUnsigned(&cursor, pUnit->offsetSize);
+        if( cursor.isError )
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        return NULL;
+    }
+
+    if( section->data == NULL || offset >= section->size ||
+        memchr(section->data + offset, 0, (size_t)(section->size - offset)) == NULL )
+    {
+        return NULL;
+    }
+
+    return (const char*)(section->data + offset);
+}
+
+bool RMSym_GetLocation( RMSym_Elf* pElf, const RMSym_Unit* pUnit, const RMSym_Value* pValue, uint64_t* pAddress )
+{
+    RMSym_Cursor cursor;
+    uint8_t operation;
+    uint64_t index;
+
+    if( pValue->cls != RMSYM_CLASS_BLOCK || pValue->length < 2 )
+    {
+        return false;
+    }
+
+    cursor.pos = pValue->block + 1;
+    cursor.end = pValue->block + pValue->length;
+    cursor.isBigEndian = pElf->isBigEndian;
+    cursor.isError = false;
+
+    /* Only a plain static address is monitored; TLS and computed locations are not */
+    operation = pValue->block[0];
+    if( operation == RMSYM_OP_ADDR )
+    {
+        *pAddress = RMSym_ReadUnsigned(&cursor, pUnit->addressSize);
+    }
+    else if( operation == RMSYM_OP_ADDRX || operation == RMSYM_OP_GNU_ADDR_INDEX )
+    {
+        RMSym_Cursor table;
+        uint64_t position;
+
+        index = RMSym_ReadULEB(&cursor);
+        position = pUnit->addrBase + index * pUnit->addressSize;
+        if( pElf->addr.data == NULL || position >= pElf->addr.size )
+        {
+            return false;
+        }
+
+        table.pos = pElf->addr.data + position;
+        table.end = pElf->addr.data + pElf->addr.size;
+        table.isBigEndian = pElf->isBigEndian;
+        table.isError = false;
+        *pAddress = RMSym_ReadUnsigned(&table, pUnit->addressSize);
+        if( table.isError )
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    return !cursor.isError && cursor.pos == cursor.end;
+}
+
+bool RMSym_IsStoredTag( uint16_t tag )
+{
+    switch( tag )
+    {
+    case RMSYM_TAG_ARRAY:
+    case RMSYM_TAG_CLASS:
+    case RMSYM_TAG_ENUMERATION:
+    case RMSYM_TAG_MEMBER:
+    case RMSYM_TAG_POINTER:
+    case RMSYM_TAG_REFERENCE:
+    case RMSYM_TAG_STRUCTURE:
+    case RMSYM_TAG_TYPEDEF:
+    case RMSYM_TAG_UNION:
+    case RMSYM_TAG_PTR_TO_MEMBER:
+    case RMSYM_TAG_SUBRANGE:
+    case RMSYM_TAG_BASE_TYPE:
+    case RMSYM_TAG_CONST:
+    case RMSYM_TAG_VARIABLE:
+    case RMSYM_TAG_VOLATILE:
+    case RMSYM_TAG_RESTRICT:
+    case RMSYM_TAG_RVALUE_REF:
+    case RMSYM_TAG_ATOMIC:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+/*-- begin: expansion of variables --*/
+
+uint32_t RMSym_FindDie( const RMSym_Dwarf* pDwarf, uint64_t offset )
+{
+    uint32_t low = 0;
+    uint32_t high = pDwarf->count;
+    uint32_t middle;
+
+    while( low < high )
+    {
+        middle = low + (high - low) / 2;
+        if( pDwarf->dies[middle].offset < offset )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if( low < pDwarf->count && pDwarf->dies[low].offset == offset )
+    {
+        return low;
+    }
+
+    return RMSYM_NONE;
+}
+
+uint32_t RMSym_StripType( const RMSym_Dwarf* pDwarf, uint64_t offset )
+{
+    uint32_t index;
+    int limit;
+
+    for( limit = 0; limit < 32 && offset != RMSYM_NO_OFFSET; limit++ )
+    {
+        index = RMSym_FindDie(pDwarf, offset);
+        if( index == RMSYM_NONE )
+        {
+            return RMSYM_NONE;
+        }
+
+        switch( pDwarf->dies[index].tag )
+        {
+        case RMSYM_TAG_TYPEDEF:
+        case RMSYM_TAG_CONST:
+        case RMSYM_TAG_VOLATILE:
+        case RMSYM_TAG_RESTRICT:
+        case RMSYM_TAG_ATOMIC:
+            offset = pDwarf->dies[index].typeOffset;
+            break;
+
+        default:
+            return index;
+        }
+    }
+
+    return RMSYM_NONE;
+}
+
+uint64_t RMSym_GetTypeSize( const RMSym_Dwarf* pDwarf, uint32_t index )
+{
+    const RMSym_Die* die;
+    uint64_t size;
+    uint32_t child;
+
+    if( index == RMSYM_NONE )
+    {
+        return 0;
+    }
+
+    die = &pDwarf->dies[index];
+    if( (die->flags & RMSYM_DIE_HAS_SIZE) != 0 )
+    {
+        return die->byteSize;
+    }
+
+    if( die->tag != RMSYM_TAG_ARRAY )
+    {
+        return 0;
+    }
+
+    size = RMSym_GetTypeSize(pDwarf, RMSym_StripType(pDwarf, die->typeOffset));
+    for( child = die->firstChild; child != RMSYM_NONE; child = pDwarf->dies[child].nextSibling )
+    {
+        if( pDwarf->dies[child].tag == RMSYM_TAG_SUBRANGE )
+        {
+            size *= ((pDwarf->dies[child].flags & RMSYM_DIE_HAS_COUNT) != 0) ? pDwarf->dies[child].count : 0;
+        }
+    }
+
+    return size;
+}
+
+uint8_t RMSym_GetKind( const RMSym_Die* pDie )
+{
+    switch( pDie->tag )
+    {
+    case RMSYM_TAG_BASE_TYPE:
+        switch( pDie->encoding )
+        {
+        case RMSYM_ATE_ADDRESS:         return RMSYM_KIND_POINTER;
+        case RMSYM_ATE_BOOLEAN:         return RMSYM_KIND_BOOL;
+        case RMSYM_ATE_COMPLEX_FLOAT:
+        case RMSYM_ATE_FLOAT:           return RMSYM_KIND_FLOAT;
+        case RMSYM_ATE_SIGNED:
+        case RMSYM_ATE_SIGNED_CHAR:     return RMSYM_KIND_SIGNED;
+        default:                        return RMSYM_KIND_UNSIGNED;
+        }
+
+    case RMSYM_TAG_POINTER:
+    case RMSYM_TAG_REFERENCE:
+    case RMSYM_TAG_RVALUE_REF:
+    case RMSYM_TAG_PTR_TO_MEMBER:
+        return RMSYM_KIND_POINTER;
+
+    case RMSYM_TAG_ENUMERATION:
+        return RMSYM_KIND_ENUM;
+
+    case RMSYM_TAG_STRUCTURE:
+    case RMSYM_TAG_CLASS:
+    case RMSYM_TAG_UNION:
+        return RMSYM_KIND_STRUCT;
+
+    case RMSYM_TAG_ARRAY:
+        return RMSYM_KIND_ARRAY;
+
+    default:
+        return RMSYM_KIND_UNKNOWN;
+    }
+}
+
+void RMSym_AddVariables( RMSym_Dwarf* pDwarf, RMSym_Builder* pBuilder )
+{
+    char name[RMSYM_NAME_SIZE];
+    uint32_t index;
+
+    for( index = 0; index < pDwarf->count; index++ )
+    {
+        const RMSym_Die* die = &pDwarf->dies[index];
+        uint32_t nameOffset = die->name;
+        uint64_t typeOffset = die->typeOffset;
+        uint64_t specOffset = die->specOffset;
+        int limit;
+
+        if( die->tag != RMSYM_TAG_VARIABLE || (die->flags & RMSYM_DIE_HAS_ADDRESS) == 0 )
+        {
+            continue;
+        }
+
+        /* Definitions out of their class or namespace take the name from the declaration */
+        for( limit = 0; limit < 4 && specOffset != RMSYM_NO_OFFSET && (nameOffset == RMSYM_NONE || typeOffset == RMSYM_NO_OFFSET); limit++ )
+        {
+            uint32_t spec = RMSym_FindDie(pDwarf, specOffset);
+
+            if( spec == RMSYM_NONE )
+            {
+                break;
+            }
+
+            if( nameOffset == RMSYM_NONE )
+            {
+                nameOffset = pDwarf->dies[spec].name;
+            }
+            if( typeOffset == RMSYM_NO_OFFSET )
+            {
+                typeOffset = pDwarf->dies[spec].typeOffset;
+            }
+            specOffset = pDwarf->dies[spec].specOffset;
+        }
+
+        if( nameOffset == RMSYM_NONE || typeOffset == RMSYM_NO_OFFSET )
+        {
+            continue;
+        }
+
+        snprintf(name, sizeof(name), "%s", pDwarf->names.data + nameOffset);
+        RMSym_Expand(pDwarf, pBuilder, name, strlen(name), die->address, typeOffset, 0, true);
+    }
+}
+
+void RMSym_Expand( RMSym_Dwarf* pDwarf, RMSym_Builder* pBuilder, char name[], size_t length, uint64_t address, uint64_t typeOffset, int depth, bool isSelf )
+{
+    uint32_t index = RMSym_StripType(pDwarf, typeOffset);
+    const RMSym_Die* type;
+    uint32_t child;
+
+    if( index == RMSYM_NONE )
+    {
+        return;
+    }
+
+    type = &pDwarf->dies[index];
+    if( isSelf )
+    {
+        RMSym_AddEntry(pBuilder, name, address, RMSym_GetTypeSize(pDwarf, index), RMSym_GetKind(type));
+    }
+
+    if( depth >= RMSYM_EXPAND_DEPTH )
+    {
+        return;
+    }
+
+    if( type->tag == RMSYM_TAG_STRUCTURE || type->tag == RMSYM_TAG_CLASS || type->tag == RMSYM_TAG_UNION )
+    {
+        for( child = type->firstChild; child != RMSYM_NONE; child = pDwarf->dies[child].nextSibling )
+        {
+            const RMSym_Die* member = &pDwarf->dies[child];
+            uint64_t offset = ((member->flags & RMSYM_DIE_HAS_OFFSET) != 0) ? member->memberOffset : 0;
+            int written;
+
+            if( member->tag != RMSYM_TAG_MEMBER ||
+                (member->flags & (RMSYM_DIE_DECLARATION | RMSYM_DIE_BITFIELD)) != 0 )
+            {
+                continue;
+            }
+
+            /* Anonymous structs and unions lend their members to the parent */
+            if( member->name == RMSYM_NONE )
+            {
+                RMSym_Expand(pDwarf, pBuilder, name, length, address + offset, member->typeOffset, depth + 1, false);
+                continue;
+            }
+
+            written = snprintf(name + length, RMSYM_NAME_SIZE - length, ".%s", pDwarf->names.data + member->name);
+            if( written > 0 && (length + (size_t)written) < RMSYM_NAME_SIZE )
+            {
+                RMSym_Expand(pDwarf, pBuilder, name, length + (size_t)written, address + offset, member->typeOffset, depth + 1, true);
+            }
+            name[length] = '\0';
+        }
+    }
+    else if( type->tag == RMSYM_TAG_ARRAY )
+    {
+        for( child = type->firstChild; child != RMSYM_NONE; child = pDwarf->dies[child].nextSibling )
+        {
+            if( pDwarf->dies[child].tag == RMSYM_TAG_SUBRANGE )
+            {
+                RMSym_ExpandArray(pDwarf, pBuilder, name, length, address, index, child, depth);
+                break;
+            }
+        }
+    }
+}
+
+void RMSym_ExpandArray( RMSym_Dwarf* pDwarf, RMSym_Builder* pBuilder, char name[], size_t length, uint64_t address, uint32_t array, uint32_t subrange, int depth )
+{
+    const RMSym_Die* dimension = &pDwarf->dies[subrange];
+    uint32_t next;
+    uint32_t child;
+    uint64_t elementSize;
+    uint64_t element;
+    int written;
+
+    if( (dimension->flags & RMSYM_DIE_HAS_COUNT) == 0 || dimension->count > pBuilder->arrayLimit )
+    {
+        return;
+    }
+
+    next = dimension->nextSibling;
+    while( next != RMSYM_NONE && pDwarf->dies[next].tag != RMSYM_TAG_SUBRANGE )
+    {
+        next = pDwarf->dies[next].nextSibling;
+    }
+
+    /* An element of a[i][j] is a row of the remaining dimensions */
+    elementSize = RMSym_GetTypeSize(pDwarf, RMSym_StripType(pDwarf, pDwarf->dies[array].typeOffset));
+    for( child = next; child != RMSYM_NONE; child = pDwarf->dies[child].nextSibling )
+    {
+        if( pDwarf->dies[child].tag == RMSYM_TAG_SUBRANGE )
+        {
+            elementSize *= ((pDwarf->dies[child].flags & RMSYM_DIE_HAS_COUNT) != 0) ? pDwarf->dies[child].count : 0;
+        }
+    }
+
+    if( elementSize == 0 )
+    {
+        return;
+    }
+
+    for( element = 0; element < dimension->count; element++ )
+    {
+        written = snprintf(name + length, RMSYM_NAME_SIZE - length, "[%llu]", (unsigned long long)element);
+        if( written <= 0 || (length + (size_t)written) >= RMSYM_NAME_SIZE )
+        {
+            break;
+        }
+
+        if( next != RMSYM_NONE )
+        {
+            RMSym_AddEntry(pBuilder, name, address + element * elementSize, elementSize, RMSYM_KIND_ARRAY);
+            RMSym_ExpandArray(pDwarf, pBuilder, name, length + (size_t)written, address + element * elementSize, array, next, depth + 1);
+        }
+        else
+        {
+            RMSym_Expand(pDwarf, pBuilder, name, length + (size_t)written, address + element * elementSize,
+                         pDwarf->dies[array].typeOffset, depth + 1, true);
+        }
+    }
+
+    name[length] = '\0';
+}
+
+/*-- begin: index and cache --*/
+
+void RMSym_Finish( RMSym_Builder* pBuilder, RMSym_Index* pIndex )
+{
+    uint32_t read;
+    uint32_t write = 0;
+
+    /* Sorted by name, then by insertion, so the first duplicate is the DWARF one */
+    rmSymSortNames = pBuilder->names.data;
+    if( pBuilder->count != 0 )
+    {
+        qsort(pBuilder->entries, pBuilder->count, sizeof(RMSym_Entry), RMSym_CompareEntry);
+    }
+
+    for( read = 0; read < pBuilder->count; read++ )
+    {
+        if( write != 0 &&
+            strcmp(pBuilder->names.data + pBuilder->entries[write - 1].nameOffset,
+                   pBuilder->names.data + pBuilder->entries[read].nameOffset) == 0 )
+        {
+            continue;
+        }
+        pBuilder->entries[write++] = pBuilder->entries[read];
+    }
+
+    pIndex->entries = pBuilder->entries;
+    pIndex->count = write;
+    pIndex->names = pBuilder->names.data;
+    pIndex->namesSize = pBuilder->names.size;
+    pIndex->isFromCache = false;
+}
+
+int RMSym_CompareEntry( const void* pLeft, const void* pRight )
+{
+    const RMSym_Entry* left = (const RMSym_Entry*)pLeft;
+    const RMSym_Entry* right = (const RMSym_Entry*)pRight;
+    int result = strcmp(rmSymSortNames + left->nameOffset, rmSymSortNames + right->nameOffset);
+
+    if( result != 0 )
+    {
+        return result;
+    }
+
+    return (left->nameOffset < right->nameOffset) ? -1 : (left->nameOffset > right->nameOffset);
+}
+
+bool RMSym_ReadCache( RMSym_Index* pIndex, const char* cachePath, const struct stat* pInfo, uint32_t arrayLimit )
+{
+    RMSym_CacheHeader header;
+    FILE* file;
+    uint32_t index;
+
+    file = fopen(cachePath, "rb");
+    if( file == NULL )
+    {
+        return false;
+    }
+
+    if( fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != RMSYM_CACHE_MAGIC || header.version != RMSYM_CACHE_VERSION ||
+        header.entrySize != sizeof(RMSym_Entry) ||
+        header.elfSize != (uint64_t)pInfo->st_size ||
+        header.elfTime != ((uint64_t)pInfo->st_mtim.tv_sec * 1000000000ULL + (uint64_t)pInfo->st_mtim.tv_nsec) ||
+        header.arrayLimit != arrayLimit )
+    {
+        fclose(file);
+        return false;
+    }
+
+    pIndex->entries = malloc((size_t)header.count * sizeof(RMSym_Entry) + 1);
+    pIndex->names = malloc((size_t)header.namesSize + 1);
+    if( pIndex->entries == NULL || pIndex->names == NULL ||
+        fread(pIndex->entries, sizeof(RMSym_Entry), header.count, file) != header.count ||
+        fread(pIndex->names, 1, header.namesSize, file) != header.namesSize )
+    {
+        fclose(file);
+        RMSym_Free(pIndex);
+        return false;
+    }
+    fclose(file);
+
+    pIndex->names[header.namesSize] = '\0';
+    for( index = 0; index < header.count; index++ )
+    {
+        if( pIndex->entries[index].nameOffset >= header.namesSize )
+        {
+            RMSym_Free(pIndex);
+            return false;
+        }
+    }
+
+    pIndex->count = header.count;
+    pIndex->namesSize = header.namesSize;
+    pIndex->isFromCache = true;
+    pIndex->isRelocatable = (header.flags & RMSYM_CACHE_FLAG_RELOCATABLE) != 0;
+
+    return true;
+}
+
+void RMSym_WriteCache( const RMSym_Index* pIndex, const char* cachePath, const struct stat* pInfo, uint32_t arrayLimit )
+{
+    RMSym_CacheHeader header;
+    char temporary[4096];
+    FILE* file;
+    bool isWritten;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = RMSYM_CACHE_MAGIC;
+    header.version = RMSYM_CACHE_VERSION;
+    header.entrySize = sizeof(RMSym_Entry);
+    header.elfSize = (uint64_t)pInfo->st_size;
+    header.elfTime = (uint64_t)pInfo->st_mtim.tv_sec * 1000000000ULL + (uint64_t)pInfo->st_mtim.tv_nsec;
+    header.arrayLimit = arrayLimit;
+    header.count = pIndex->count;
+    header.namesSize = pIndex->namesSize;
+    header.flags = pIndex->isRelocatable ? RMSYM_CACHE_FLAG_RELOCATABLE : 0;
+
+    /* A concurrent reader sees the old cache or the new one, never a partial file */
+    snprintf(temporary, sizeof(temporary), "%s.%ld", cachePath, (long)getpid());
+    file = fopen(temporary, "wb");
+    if( file == NULL )
+    {
+        perror(cachePath);
+        return;
+    }
+
+    isWritten = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                fwrite(pIndex->entries, sizeof(RMSym_Entry), pIndex->count, file) == pIndex->count &&
+                fwrite(pIndex->names, 1, pIndex->namesSize, file) == pIndex->namesSize;
+
+    if( fclose(file) != 0 || !isWritten || rename(temporary, cachePath) != 0 )
+    {
+        perror(cachePath);
+        unlink(temporary);
+    }
+}
+
+/*-- end of file --*/
@@ -0,0 +1,63 @@
+#ifndef RM_SYM_INDEX_H
+#define RM_SYM_INDEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Symbol index of an ELF image for building RM Classic view files.
+ *
+ * Global variables are collected from the ELF symbol table and from DWARF
+ * (versions 2 to 5). With DWARF, struct/union members are expanded as
+ * "var.member" and arrays up to a limit as "var[i]". The index is sorted by name
+ * and saved next to the image, so the next run only reads the cache while
+ * the image is unchanged.
+ */
+
+#define RMSYM_CACHE_MAGIC       0x58444953UL   /* "SIDX" */
+#define RMSYM_CACHE_VERSION     2
+#define RMSYM_NAME_SIZE         256
+
+typedef enum
+{
+    RMSYM_KIND_UNKNOWN = 0,
+    RMSYM_KIND_UNSIGNED,
+    RMSYM_KIND_SIGNED,
+    RMSYM_KIND_FLOAT,
+    RMSYM_KIND_BOOL,
+    RMSYM_KIND_POINTER,
+    RMSYM_KIND_ENUM,
+    RMSYM_KIND_STRUCT,
+    RMSYM_KIND_ARRAY
+} RMSym_Kind;
+
+typedef struct RMSYM_ENTRY
+{
+    uint64_t address;
+    uint32_t size;
+    uint32_t nameOffset;        // into RMSym_Index.names
+    uint8_t  kind;              // RMSym_Kind
+    uint8_t  reserved[7];
+} RMSym_Entry;
+
+typedef struct RMSYM_INDEX
+{
+    RMSym_Entry* entries;       // sorted by name
+    uint32_t count;
+    char* names;
+    uint32_t namesSize;
+    bool isFromCache;
+    bool isRelocatable;         // ET_DYN (PIE) image, addresses are offsets from its load address
+} RMSym_Index;
+
+bool RMSym_Load( RMSym_Index* pIndex, const char* elfPath, const char* cachePath, uint32_t arrayLimit );
+void RMSym_Free( RMSym_Index* pIndex );
+void RMSym_Relocate( RMSym_Index* pIndex, uint64_t bias );
+
+const RMSym_Entry* RMSym_Find( const RMSym_Index* pIndex, const char* name );
+const RMSym_Entry* RMSym_FindPrefix( const RMSym_Index* pIndex, const char* prefix, uint32_t* pCount );
+const char* RMSym_GetName( const RMSym_Index* pIndex, const RMSym_Entry* pEntry );
+
+#endif  /* RM_SYM_INDEX_H */
+
+/*-- end of file --*/
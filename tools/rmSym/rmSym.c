@@ -0,0 +1,495 @@
+// Host tool that resolves symbols of a firmware image and writes RM Classic view files.
+//
+// usage: rmSym [-n] [-c cache] [-a limit] [-b bias] [-v] <elf> list [prefix]
+//        rmSym [-n] [-c cache] [-a limit] [-b bias] [-v] <elf> refresh <in.rmxml> [out.rmxml]
+//        rmSym [-n] [-c cache] [-a limit] [-b bias] [-v] <elf> emit <symbol>... > out.rmxml
+//
+//   -n        do not read or write the index cache (<elf>.rmidx by default)
+//   -c cache  path of the index cache
+//   -a limit  expand arrays with up to this many elements as "var[i]" (default 16)
+//   -b bias   load address added to every symbol, for position-independent (PIE) images
+//   -v        print the index size and timings to stderr
+
+#include "RmSymIndex.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RMSYM_DEFAULT_ARRAY_LIMIT   16
+
+static const char* rmSymKindName[] =
+{
+    "-", "unsigned", "signed", "float", "bool", "pointer", "enum", "struct", "array"
+};
+
+/*-- begin: prototype of function --*/
+
+double RMSym_Millis( void );
+char*  RMSym_ReadFile( const char* path, size_t* pSize );
+void   RMSym_PrintEscaped( FILE* file, const char* text, size_t length );
+size_t RMSym_Unescape( char output[], size_t outputSize, const char* text, size_t length );
+void   RMSym_PrintAddress( FILE* file, uint64_t address );
+void   RMSym_PrintSetting( FILE* file, const char* name, uint64_t address, uint32_t size, uint8_t kind );
+int    RMSym_CompareAddress( const void* pLeft, const void* pRight );
+
+int RMSym_List( const RMSym_Index* pIndex, const char* prefix );
+int RMSym_Refresh( const RMSym_Index* pIndex, const char* inPath, const char* outPath );
+int RMSym_Emit( const RMSym_Index* pIndex, int count, char* symbols[] );
+
+/*-- begin: functions --*/
+
+int main(int argc, char* argv[])
+{
+    RMSym_Index index;
+    const char* cachePath = NULL;
+    char defaultCache[4096];
+    bool isCached = true;
+    bool isVerbose = false;
+    uint32_t arrayLimit = RMSYM_DEFAULT_ARRAY_LIMIT;
+    uint64_t bias = 0;
+    bool isBiased = false;
+    const char* command;
+    double start;
+    int option;
+    int result;
+
+    while( (option = getopt(argc, argv, "nc:a:b:v")) != -1 )
+    {
+        switch( option )
+        {
+        case 'n':
+            isCached = false;
+            break;
+        case 'c':
+            cachePath = optarg;
+            break;
+        case 'a':
+            arrayLimit = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'b':
+            bias = (uint64_t)strtoull(optarg, NULL, 0);
+            isBiased = true;
+            break;
+        case 'v':
+            isVerbose = true;
+            break;
+        default:
+            argc = 0;
+            break;
+        }
+    }
+
+    if( (argc - optind) < 2 )
+    {
+        fprintf(stderr, "usage: rmSym [-n] [-c cache] [-a limit] [-b bias] [-v] <elf> list [prefix]\n"
+                        "       rmSym [-n] [-c cache] [-a limit] [-b bias] [-v] <elf> refresh <in.rmxml> [out.rmxml]\n"
+                        "       rmSym [-n] [-c cache] [-a limit] [-b bias] [-v] <elf> emit <symbol>...\n");
+        return 1;
+    }
+
+    if( isCached && cachePath == NULL )
+    {
+        snprintf(defaultCache, sizeof(defaultCache), "%s.rmidx", argv[optind]);
+        cachePath = defaultCache;
+    }
+
+    start = RMSym_Millis();
+    if( !RMSym_Load(&index, argv[optind], isCached ? cachePath : NULL, arrayLimit) )
+    {
+        return 1;
+    }
+
+    /* The cache keeps the addresses of the image, the bias only applies to this run */
+    if( isBiased )
+    {
+        RMSym_Relocate(&index, bias);
+    }
+    else if( index.isRelocatable )
+    {
+        fprintf(stderr, "rmSym: %s is position-independent, its addresses are offsets from the load address.\n"
+                        "       Link it with -no-pie, or pass the load address with -b.\n", argv[optind]);
+    }
+
+    if( isVerbose )
+    {
+        fprintf(stderr, "rmSym: %u symbols %s in %.2f ms\n", index.count,
+                index.isFromCache ? "read from the cache" : "indexed", RMSym_Millis() - start);
+    }
+
+    start = RMSym_Millis();
+    command = argv[optind + 1];
+    if( strcmp(command, "list") == 0 )
+    {
+        result = RMSym_List(&index, ((argc - optind) >= 3) ? argv[optind + 2] : "");
+    }
+    else if( strcmp(command, "refresh") == 0 && (argc - optind) >= 3 )
+    {
+        result = RMSym_Refresh(&index, argv[optind + 2], ((argc - optind) >= 4) ? argv[optind + 3] : argv[optind + 2]);
+    }
+    else if( strcmp(command, "emit") == 0 && (argc - optind) >= 3 )
+    {
+        result = RMSym_Emit(&index, argc - optind - 2, &argv[optind + 2]);
+    }
+    else
+    {
+        fprintf(stderr, "rmSym: unknown command %s\n", command);
+        result = 1;
+    }
+
+    if( isVerbose )
+    {
+        fprintf(stderr, "rmSym: %s took %.2f ms\n", command, RMSym_Millis() - start);
+    }
+
+    RMSym_Free(&index);
+    return result;
+}
+
+/**
+ * @fn int RMSym_List(const RMSym_Index* pIndex, const char* prefix)
+ * @brief Prints address, size, kind and name of every symbol that starts with prefix.
+ */
+int RMSym_List( const RMSym_Index* pIndex, const char* prefix )
+{
+    const RMSym_Entry* entry;
+    uint32_t count;
+    uint32_t index;
+
+    entry = RMSym_FindPrefix(pIndex, prefix, &count);
+    for( index = 0; index < count; index++ )
+    {
+        RMSym_PrintAddress(stdout, entry[index].address);
+        printf(" %6u %-8s %s\n", entry[index].size, rmSymKindName[entry[index].kind], RMSym_GetName(pIndex, &entry[index]));
+    }
+
+    return 0;
+}
+
+/**
+ * @fn int RMSym_Refresh(const RMSym_Index* pIndex, const char* inPath, const char* outPath)
+ * @brief Rewrites the <Address> of every <DataSetting> that names a <Symbol>.
+ *
+ * Everything else in the file is copied as is. Symbols that are not found keep
+ * their address and are reported.
+ */
+int RMSym_Refresh( const RMSym_Index* pIndex, const char* inPath, const char* outPath )
+{
+    static const char symbolTag[] = "<Symbol>";
+    static const char addressTag[] = "<Address>";
+    char temporary[4096];
+    char symbol[RMSYM_NAME_SIZE];
+    const RMSym_Entry* entry;
+    const char* cursor;
+    const char* found;
+    const char* symbolEnd;
+    const char* settingEnd;
+    const char* address;
+    const char* addressEnd;
+    uint32_t updated = 0;
+    uint32_t missing = 0;
+    size_t size;
+    char* text;
+    FILE* file;
+
+    text = RMSym_ReadFile(inPath, &size);
+    if( text == NULL )
+    {
+        perror(inPath);
+        return 1;
+    }
+
+    snprintf(temporary, sizeof(temporary), "%s.%ld", outPath, (long)getpid());
+    file = fopen(temporary, "wb");
+    if( file == NULL )
+    {
+        perror(outPath);
+        free(text);
+        return 1;
+    }
+
+    cursor = text;
+    while( (found = strstr(cursor, symbolTag)) != NULL )
+    {
+        found += sizeof(symbolTag) - 1;
+        symbolEnd = strstr(found, "</Symbol>");
+        settingEnd = strstr(found, "</DataSetting>");
+        address = strstr(found, addressTag);
+        if( symbolEnd == NULL || address == NULL || (settingEnd != NULL && address > settingEnd) )
+        {
+            fwrite(cursor, 1, (size_t)(found - cursor), file);
+            cursor = found;
+            continue;
+        }
+
+        address += sizeof(addressTag) - 1;
+        addressEnd = strstr(address, "</Address>");
+        if( addressEnd == NULL )
+        {
+            break;
+        }
+
+        RMSym_Unescape(symbol, sizeof(symbol), found, (size_t)(symbolEnd - found));
+        entry = RMSym_Find(pIndex, symbol);
+
+        fwrite(cursor, 1, (size_t)(address - cursor), file);
+        if( entry != NULL )
+        {
+            RMSym_PrintAddress(file, entry->address);
+            updated++;
+        }
+        else
+        {
+            fwrite(address, 1, (size_t)(addressEnd - address), file);
+            fprintf(stderr, "rmSym: %s is not found, the address is kept\n", symbol);
+            missing++;
+        }
+        cursor = addressEnd;
+    }
+    fputs(cursor, file);
+    free(text);
+
+    if( fclose(file) != 0 || rename(temporary, outPath) != 0 )
+    {
+        perror(outPath);
+        unlink(temporary);
+        return 1;
+    }
+
+    fprintf(stderr, "rmSym: %u addresses updated, %u not found\n", updated, missing);
+    return (missing == 0) ? 0 : 2;
+}
+
+/**
+ * @fn int RMSym_Emit(const RMSym_Index* pIndex, int count, char* symbols[])
+ * @brief Writes a new view file with the given symbols to stdout.
+ *
+ * A struct or array symbol becomes a group of its scalar members in address order.
+ */
+int RMSym_Emit( const RMSym_Index* pIndex, int count, char* symbols[] )
+{
+    const RMSym_Entry* entry;
+    const RMSym_Entry* member;
+    const RMSym_Entry** members;
+    uint32_t memberCount;
+    uint32_t selected;
+    uint32_t index;
+    size_t length;
+    int result = 0;
+    int symbol;
+
+    printf("<?xml version=\"1.0\"?>\n");
+    printf("<ViewSetting xmlns:xsd=\"http://www.w3.org/2001/XMLSchema\" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\">\n");
+
+    for( symbol = 0; symbol < count; symbol++ )
+    {
+        entry = RMSym_Find(pIndex, symbols[symbol]);
+        if( entry == NULL )
+        {
+            fprintf(stderr, "rmSym: %s is not found\n", symbols[symbol]);
+            result = 2;
+            continue;
+        }
+
+        if( entry->kind != RMSYM_KIND_STRUCT && entry->kind != RMSYM_KIND_ARRAY )
+        {
+            RMSym_PrintSetting(stdout, symbols[symbol], entry->address, entry->size, entry->kind);
+            continue;
+        }
+
+        member = RMSym_FindPrefix(pIndex, symbols[symbol], &memberCount);
+        members = malloc(sizeof(*members) * (memberCount + 1));
+        if( members == NULL )
+        {
+            return 1;
+        }
+
+        length = strlen(symbols[symbol]);
+        selected = 0;
+        for( index = 0; index < memberCount; index++ )
+        {
+            const char* name = RMSym_GetName(pIndex, &member[index]);
+
+            if( (name[length] == '.' || name[length] == '[') &&
+                member[index].kind != RMSYM_KIND_STRUCT && member[index].kind != RMSYM_KIND_ARRAY )
+            {
+                members[selected++] = &member[index];
+            }
+        }
+
+        /* Large arrays are not expanded, they are shown from their first byte */
+        if( selected == 0 )
+        {
+            RMSym_PrintSetting(stdout, symbols[symbol], entry->address, entry->size, entry->kind);
+            free(members);
+            continue;
+        }
+
+        qsort(members, selected, sizeof(*members), RMSym_CompareAddress);
+
+        printf("  <DataSetting>\n");
+        printf("    <Group>");
+        RMSym_PrintEscaped(stdout, symbols[symbol], length);
+        printf("</Group>\n");
+        printf("    <Check>false</Check>\n");
+        printf("    <Offset>0</Offset>\n");
+        printf("    <Size>1</Size>\n");
+        printf("    <Type>Hex</Type>\n");
+        printf("  </DataSetting>\n");
+
+        for( index = 0; index < selected; index++ )
+        {
+            RMSym_PrintSetting(stdout, RMSym_GetName(pIndex, members[index]),
+                               members[index]->address, members[index]->size, members[index]->kind);
+        }
+        free(members);
+    }
+
+    printf("</ViewSetting>\n");
+    return result;
+}
+
+/*-- begin: helpers --*/
+
+double RMSym_Millis( void )
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1000000.0;
+}
+
+char* RMSym_ReadFile( const char* path, size_t* pSize )
+{
+    FILE* file;
+    char* text;
+    long size;
+
+    file = fopen(path, "rb");
+    if( file == NULL )
+    {
+        return NULL;
+    }
+
+    if( fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0 )
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    text = malloc((size_t)size + 1);
+    if( text == NULL || fread(text, 1, (size_t)size, file) != (size_t)size )
+    {
+        free(text);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+
+    text[size] = '\0';
+    *pSize = (size_t)size;
+    return text;
+}
+
+void RMSym_PrintEscaped( FILE* file, const char* text, size_t length )
+{
+    size_t index;
+
+    for( index = 0; index < length; index++ )
+    {
+        switch( text[index] )
+        {
+        case '&':   fputs("&amp;", file);   break;
+        case '<':   fputs("&lt;", file);    break;
+        case '>':   fputs("&gt;", file);    break;
+        default:    fputc(text[index], file); break;
+        }
+    }
+}
+
+size_t RMSym_Unescape( char output[], size_t outputSize, const char* text, size_t length )
+{
+    static const struct { const char* entity; char character; } entities[] =
+    {
+        { "&amp;", '&' }, { "&lt;", '<' }, { "&gt;", '>' }, { "&quot;", '"' }, { "&apos;", '\'' }
+    };
+    size_t read = 0;
+    size_t written = 0;
+    size_t entity;
+
+    while( read < length && (written + 1) < outputSize )
+    {
+        for( entity = 0; entity < (sizeof(entities) / sizeof(entities[0])); entity++ )
+        {
+            size_t size = strlen(entities[entity].entity);
+
+            if( (length - read) >= size && strncmp(text + read, entities[entity].entity, size) == 0 )
+            {
+                break;
+            }
+        }
+
+        if( entity < (sizeof(entities) / sizeof(entities[0])) )
+        {
+            output[written++] = entities[entity].character;
+            read += strlen(entities[entity].entity);
+        }
+        else
+        {
+            output[written++] = text[read++];
+        }
+    }
+
+    output[written] = '\0';
+    return written;
+}
+
+void RMSym_PrintAddress( FILE* file, uint64_t address )
+{
+    if( address > 0xFFFFFFFFULL )
+    {
+        fprintf(file, "0x%016llx", (unsigned long long)address);
+    }
+    else
+    {
+        fprintf(file, "0x%08llx", (unsigned long long)address);
+    }
+}
+
+void RMSym_PrintSetting( FILE* file, const char* name, uint64_t address, uint32_t size, uint8_t kind )
+{
+    bool isDecimal = (kind == RMSYM_KIND_UNSIGNED || kind == RMSYM_KIND_SIGNED ||
+                      kind == RMSYM_KIND_BOOL || kind == RMSYM_KIND_ENUM);
+
+    /* RM Classic reads 1, 2, 4 or 8 bytes, anything else is shown from its first byte */
+    if( size != 1 && size != 2 && size != 4 && size != 8 )
+    {
+        size = 1;
+        isDecimal = false;
+    }
+
+    fprintf(file, "  <DataSetting>\n");
+    fprintf(file, "    <Check>true</Check>\n");
+    fprintf(file, "    <Symbol>");
+    RMSym_PrintEscaped(file, name, strlen(name));
+    fprintf(file, "</Symbol>\n");
+    fprintf(file, "    <Address>");
+    RMSym_PrintAddress(file, address);
+    fprintf(file, "</Address>\n");
+    fprintf(file, "    <Offset>0</Offset>\n");
+    fprintf(file, "    <Size>%u</Size>\n", size);
+    fprintf(file, "    <Type>%s</Type>\n", isDecimal ? "Dec" : "Hex");
+    fprintf(file, "  </DataSetting>\n");
+}
+
+int RMSym_CompareAddress( const void* pLeft, const void* pRight )
+{
+    const RMSym_Entry* left = *(const RMSym_Entry* const*)pLeft;
+    const RMSym_Entry* right = *(const RMSym_Entry* const*)pRight;
+
+    return (left->address < right->address) ? -1 : (left->address > right->address);
+}
+
+/*-- end of file --*/